@@ -0,0 +1,133 @@
+#include "AhoCorasick.h"
+#include <algorithm>
+
+namespace utils {
+
+void AhoCorasick::Build( const std::vector<std::string_view> &patterns ) {
+    // 字节等价类：出现在模式串中的每个字节单独成类，其余字节共用类0
+    byte_class_.fill( 0 );
+    class_count_ = 1;
+    max_length_  = 0;
+    pattern_length_.clear();
+    for ( const auto &pattern : patterns ) {
+        pattern_length_.push_back( static_cast<uint32_t>( pattern.size() ) );
+        max_length_ = std::max( max_length_, pattern.size() );
+        for ( const char c : pattern ) {
+            auto &cls = byte_class_[static_cast<unsigned char>( c )];
+            if ( cls == 0 ) {
+                cls = static_cast<uint16_t>( class_count_++ );
+            }
+        }
+    }
+
+    BuildAutomaton( patterns, false, transitions_, depth_, output_ );
+    std::vector<uint32_t> reverse_depth;
+    BuildAutomaton( patterns, true, reverse_transitions_, reverse_depth, reverse_output_ );
+}
+
+void AhoCorasick::BuildAutomaton( const std::vector<std::string_view> &patterns, bool reverse,
+                                  std::vector<uint32_t> &transitions, std::vector<uint32_t> &depth,
+                                  std::vector<uint32_t> &output ) const {
+    constexpr uint32_t kAbsent = UINT32_MAX;
+
+    // 构建字典树；reverse 为 true 时插入逆序的模式串
+    transitions.assign( class_count_, kAbsent );
+    depth.assign( 1, 0 );
+    output.assign( 1, kNoOutput );
+    for ( size_t id = 0; id < patterns.size(); ++id ) {
+        const auto &pattern = patterns[id];
+        if ( pattern.empty() ) {
+            continue;
+        }
+        uint32_t state = 0;
+        for ( size_t k = 0; k < pattern.size(); ++k ) {
+            const char   c     = reverse ? pattern[pattern.size() - 1 - k] : pattern[k];
+            const size_t index =
+                static_cast<size_t>( state ) * class_count_ + byte_class_[static_cast<unsigned char>( c )];
+            if ( transitions[index] == kAbsent ) {
+                transitions[index] = static_cast<uint32_t>( depth.size() );
+                transitions.resize( transitions.size() + class_count_, kAbsent );
+                depth.push_back( depth[state] + 1 );
+                output.push_back( kNoOutput );
+            }
+            state = transitions[index];
+        }
+        if ( output[state] == kNoOutput ) {
+            output[state] = static_cast<uint32_t>( id );
+        }
+    }
+
+    // 广度优先计算失败链接，并把缺失的转移补全为稠密DFA
+    std::vector<uint32_t> fail( depth.size(), 0 );
+    std::vector<uint32_t> queue;
+    queue.reserve( depth.size() );
+    queue.push_back( 0 );
+    for ( size_t head = 0; head < queue.size(); ++head ) {
+        const uint32_t state = queue[head];
+        for ( size_t cls = 0; cls < class_count_; ++cls ) {
+            const size_t   index = static_cast<size_t>( state ) * class_count_ + cls;
+            const uint32_t child = transitions[index];
+            const uint32_t fallback =
+                state == 0 ? 0 : transitions[static_cast<size_t>( fail[state] ) * class_count_ + cls];
+            if ( child == kAbsent ) {
+                transitions[index] = fallback;
+                continue;
+            }
+            fail[child] = fallback;
+            // 自身不是模式串终点时，继承失败链接上的最长模式串
+            if ( output[child] == kNoOutput ) {
+                output[child] = output[fallback];
+            }
+            queue.push_back( child );
+        }
+    }
+}
+
+std::optional<AhoCorasick::Match> AhoCorasick::FindNext( std::string_view text, size_t pos ) const noexcept {
+    if ( max_length_ == 0 ) {
+        return std::nullopt;
+    }
+
+    uint32_t state = 0;
+    bool     found = false;
+    Match    best{};
+    for ( size_t i = pos; i < text.size(); ) {
+        state = Next( state, static_cast<unsigned char>( text[i] ) );
+        ++i;
+
+        const uint32_t id = output_[state];
+        if ( id != kNoOutput ) {
+            const size_t length = pattern_length_[id];
+            const size_t offset = i - length;
+            if ( !found || offset < best.offset || ( offset == best.offset && length > best.length ) ) {
+                best  = Match{ id, offset, length };
+                found = true;
+            }
+        }
+        // 之后的匹配起点不会早于 i - depth，候选已不可能被更左或更长的匹配取代
+        if ( found && i - depth_[state] > best.offset ) {
+            return best;
+        }
+    }
+    if ( found ) {
+        return best;
+    }
+    return std::nullopt;
+}
+
+void AhoCorasick::FillLongestMatches( std::string_view text, size_t begin, size_t end, uint32_t *ids ) const noexcept {
+    // 逆序扫描时，反向自动机在 j 处输出的最长（逆序）模式串就是以 text[j] 开头的最长模式串。
+    // 它只取决于 text[j, j + max_length_)，所以从 end + max_length_ - 1 开始扫描即可
+    const size_t start = std::min( text.size(), end + max_length_ - 1 );
+    uint32_t     state = 0;
+    for ( size_t j = start; j > begin; ) {
+        --j;
+        state = reverse_transitions_[static_cast<size_t>( state ) * class_count_ +
+                                     byte_class_[static_cast<unsigned char>( text[j] )]];
+        if ( j < end ) {
+            ids[j - begin] = reverse_output_[state];
+        }
+    }
+}
+
+}  // namespace utils
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief 多模式串匹配自动机（Aho-Corasick）
+ *
+ * 构造时一次性编译所有模式串，之后可在任意文本上重复使用，单次扫描即可找出所有模式串。
+ * 内部对字节做等价类压缩并生成稠密转移表，匹配时每个字节只需一次查表。
+ * 另外为逆序的模式串构建一份转移表，使 ForEachMatch 遍历所有匹配时每个字节只需扫描常数次。
+ *
+ * 匹配语义为“最左最长、不重叠”：优先返回起始位置最靠左的匹配，起始位置相同时返回最长的模式串。
+ * 空模式串会被忽略；重复的模式串以第一次出现的编号为准。
+ *
+ * @code{.cpp}
+ *   AhoCorasick ac( { "he", "she", "hers" } );
+ *   auto match = ac.FindNext( "ushers" );
+ *   // match->pattern = 1 ("she"), match->offset = 1, match->length = 3
+ * @endcode
+ */
+class AhoCorasick {
+public:
+    struct Match {
+        size_t pattern;  ///< 模式串编号（构造时的顺序）
+        size_t offset;   ///< 匹配在文本中的起始位置
+        size_t length;   ///< 匹配长度
+    };
+
+    AhoCorasick() { Build( {} ); }
+    AhoCorasick( std::initializer_list<std::string_view> patterns ) {
+        Build( std::vector<std::string_view>( patterns ) );
+    }
+    /**
+     * @brief 由任意字符串容器构造（元素需可转换为 std::string_view）
+     */
+    template <typename Container>
+    explicit AhoCorasick( const Container &patterns ) {
+        std::vector<std::string_view> views;
+        for ( const auto &pattern : patterns ) {
+            views.emplace_back( pattern );
+        }
+        Build( views );
+    }
+
+    /// 模式串数量（包括被忽略的空模式串）
+    [[nodiscard]] size_t PatternCount() const noexcept { return pattern_length_.size(); }
+    /// 最长模式串长度
+    [[nodiscard]] size_t MaxPatternLength() const noexcept { return max_length_; }
+
+    /**
+     * @brief 从pos开始查找下一个匹配（最左最长）
+     *
+     * 为确认没有更长的匹配，找到匹配后最多还会向后预读 MaxPatternLength() 个字节。
+     * 逐个调用 FindNext 遍历所有匹配时预读部分会被重复扫描，遍历请使用 ForEachMatch。
+     *
+     * @param text 文本
+     * @param pos 起始查找位置
+     * @return 匹配信息；无匹配时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<Match> FindNext( std::string_view text, size_t pos = 0 ) const noexcept;
+
+    /**
+     * @brief 依次回调所有不重叠的匹配
+     *
+     * 按块逆序扫描求出每个位置开始的最长模式串，再从左到右贪心选取，
+     * 总复杂度与文本长度成线性关系，与模式串长度和匹配数量无关。
+     *
+     * @param text 文本
+     * @param on_match 回调，参数为 const Match&；返回 false 时停止查找（也可返回 void）
+     */
+    template <typename Func>
+    void ForEachMatch( std::string_view text, Func &&on_match ) const {
+        if ( max_length_ == 0 || text.empty() ) {
+            return;
+        }
+        // 块长不小于最长模式串，每块额外扫描的 max_length_ 字节均摊后不超过块长
+        const size_t          block = std::min( text.size(), std::max( kScanBlock, max_length_ ) );
+        std::vector<uint32_t> longest( block );
+        size_t                pos = 0;
+        while ( pos < text.size() ) {
+            const size_t end = std::min( pos + block, text.size() );
+            FillLongestMatches( text, pos, end, longest.data() );
+            size_t next = pos;
+            while ( next < end ) {
+                const uint32_t id = longest[next - pos];
+                if ( id == kNoOutput ) {
+                    ++next;
+                    continue;
+                }
+                const Match match{ id, next, pattern_length_[id] };
+                if constexpr ( std::is_same_v<decltype( on_match( match ) ), bool> ) {
+                    if ( !on_match( match ) ) {
+                        return;
+                    }
+                }
+                else {
+                    on_match( match );
+                }
+                next += match.length;
+            }
+            pos = next;
+        }
+    }
+
+private:
+    void Build( const std::vector<std::string_view> &patterns );
+    /// 按当前的字节等价类构建稠密转移表；reverse 为 true 时使用逆序的模式串
+    void BuildAutomaton( const std::vector<std::string_view> &patterns, bool reverse,
+                         std::vector<uint32_t> &transitions, std::vector<uint32_t> &depth,
+                         std::vector<uint32_t> &output ) const;
+    /// 写入 ids[j - begin] = 以 text[j] 开头的最长模式串编号（无则为 kNoOutput），j ∈ [begin, end)
+    void FillLongestMatches( std::string_view text, size_t begin, size_t end, uint32_t *ids ) const noexcept;
+
+    uint32_t Next( uint32_t state, unsigned char c ) const noexcept {
+        return transitions_[static_cast<size_t>( state ) * class_count_ + byte_class_[c]];
+    }
+
+    static constexpr uint32_t kNoOutput  = UINT32_MAX;
+    static constexpr size_t   kScanBlock = 4096;  ///< ForEachMatch 每次逆序扫描的块长
+
+    std::array<uint16_t, 256> byte_class_{};  ///< 字节 -> 等价类，未出现在模式串中的字节均为0
+    size_t                    class_count_ = 1;
+    size_t                    max_length_  = 0;
+    std::vector<uint32_t>     transitions_;          ///< 稠密转移表 [state * class_count_ + class]
+    std::vector<uint32_t>     depth_;                ///< 状态对应前缀的长度
+    std::vector<uint32_t>     output_;               ///< 以该状态结尾的最长模式串编号
+    std::vector<uint32_t>     pattern_length_;       ///< 各模式串长度
+    std::vector<uint32_t>     reverse_transitions_;  ///< 逆序模式串的稠密转移表，供 ForEachMatch 使用
+    std::vector<uint32_t>     reverse_output_;       ///< 逆序自动机中以该状态结尾的最长模式串编号
+};
+
+}  // namespace utils
@@ -0,0 +1,41 @@
+#include "Base64Stream.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace utils {
+
+void Base64StreamEncoder::Update( std::string_view chunk, std::string &out ) {
+    if ( chunk.empty() ) {
+        return;
+    }
+    consumed_ += chunk.size();
+    // 先与暂存的尾部拼成完整的一组
+    if ( pending_size_ > 0 ) {
+        const size_t take = std::min( 3 - pending_size_, chunk.size() );
+        char         group[3];
+        std::memcpy( group, pending_, pending_size_ );
+        std::memcpy( group + pending_size_, chunk.data(), take );
+        chunk.remove_prefix( take );
+        if ( pending_size_ + take < 3 ) {
+            std::memcpy( pending_, group, pending_size_ + take );
+            pending_size_ += take;
+            return;
+        }
+        pending_size_ = 0;
+        StringUtil::AppendBase64Encoded( out, std::string_view( group, 3 ), alphabet_, padding_ );
+    }
+
+    const size_t remainder = chunk.size() % 3;
+    StringUtil::AppendBase64Encoded( out, chunk.substr( 0, chunk.size() - remainder ), alphabet_, padding_ );
+    for ( size_t i = chunk.size() - remainder; i < chunk.size(); ++i ) {
+        pending_[pending_size_++] = chunk[i];
+    }
+}
+
+void Base64StreamEncoder::Finish( std::string &out ) {
+    StringUtil::AppendBase64Encoded( out, std::string_view( pending_, pending_size_ ), alphabet_, padding_ );
+    pending_size_ = 0;
+}
+
+}  // namespace utils
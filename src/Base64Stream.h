@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "StringUtil.h"
+
+namespace utils {
+
+/**
+ * @brief 流式 Base64 编码器，逐块消费输入，把编码结果追加到调用方的缓冲区
+ *
+ * 每次 Update 只输出完整的3字节组，不足3字节的尾部暂存在编码器内部，与下一块拼接；
+ * Finish 输出暂存的尾部及填充。分块方式不影响结果，与对完整数据调用 StringUtil::Base64Encode 一致。
+ * 调用方可以在两次 Update 之间把 out 写出并清空，从而以固定内存编码任意大小的文件。
+ *
+ * @code{.cpp}
+ *   Base64StreamEncoder encoder;
+ *   std::string         out;
+ *   while ( ReadChunk( buffer ) ) {
+ *       encoder.Update( buffer, out );
+ *       Write( out );
+ *       out.clear();
+ *   }
+ *   encoder.Finish( out );
+ *   Write( out );
+ * @endcode
+ */
+class Base64StreamEncoder {
+public:
+    /**
+     * @param alphabet 字母表
+     * @param padding 是否补齐 '='
+     */
+    explicit Base64StreamEncoder( Base64Alphabet alphabet = Base64Alphabet::kStandard, bool padding = true ) noexcept
+        : alphabet_( alphabet ), padding_( padding ) {}
+
+    /// 累计已消费的字节数
+    [[nodiscard]] uint64_t Consumed() const noexcept { return consumed_; }
+
+    /**
+     * @brief 输入一块数据
+     * @param chunk 数据块，只需在本次调用期间有效
+     * @param out [out] 编码结果追加到末尾
+     */
+    void Update( std::string_view chunk, std::string &out );
+    /**
+     * @brief 输出暂存的尾部及填充，之后可以开始编码新的一段数据
+     * @param out [out] 编码结果追加到末尾
+     */
+    void Finish( std::string &out );
+
+private:
+    Base64Alphabet alphabet_;
+    bool           padding_;
+    char           pending_[2]{};  ///< 不足3字节的尾部
+    size_t         pending_size_ = 0;
+    uint64_t       consumed_     = 0;
+};
+
+}  // namespace utils
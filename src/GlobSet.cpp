@@ -0,0 +1,269 @@
+#include "GlobSet.h"
+#include <algorithm>
+
+namespace utils {
+
+void GlobSet::Insert( Trie &trie, std::string_view key, size_t id ) {
+    auto  &nodes = trie.nodes;
+    size_t node  = 0;
+    for ( const char c : key ) {
+        const auto uc   = static_cast<unsigned char>( c );
+        auto       iter = nodes[node].children.find( uc );
+        if ( iter == nodes[node].children.end() ) {
+            size_t child = nodes.size();
+            if ( trie.free.empty() ) {
+                nodes.emplace_back();
+            }
+            else {
+                child = trie.free.back();
+                trie.free.pop_back();
+            }
+            nodes[node].children.emplace( uc, child );
+            node = child;
+        }
+        else {
+            node = iter->second;
+        }
+    }
+    nodes[node].ids.push_back( id );
+}
+
+void GlobSet::Erase( Trie &trie, std::string_view key, size_t id ) {
+    auto               &nodes = trie.nodes;
+    std::vector<size_t> path{ 0 };
+    path.reserve( key.size() + 1 );
+    for ( const char c : key ) {
+        auto iter = nodes[path.back()].children.find( static_cast<unsigned char>( c ) );
+        if ( iter == nodes[path.back()].children.end() ) {
+            return;
+        }
+        path.push_back( iter->second );
+    }
+    EraseId( nodes[path.back()].ids, id );
+
+    // 沿路径回溯，回收不再被任何模式使用的节点；根节点保留
+    for ( size_t depth = key.size(); depth > 0; --depth ) {
+        TrieNode &node = nodes[path[depth]];
+        if ( !node.ids.empty() || !node.children.empty() ) {
+            break;
+        }
+        node.ids.shrink_to_fit();
+        nodes[path[depth - 1]].children.erase( static_cast<unsigned char>( key[depth - 1] ) );
+        trie.free.push_back( path[depth] );
+    }
+}
+
+void GlobSet::EraseId( std::vector<size_t> &ids, size_t id ) {
+    auto iter = std::find( ids.begin(), ids.end(), id );
+    if ( iter != ids.end() ) {
+        *iter = ids.back();
+        ids.pop_back();
+    }
+}
+
+size_t GlobSet::Add( std::string_view pattern ) {
+    const size_t id = next_id_++;
+
+    // 选择最有区分度的字面量作为索引键
+    IndexKind   kind = IndexKind::kUnindexed;
+    std::string key;
+
+    const size_t first_wildcard = pattern.find_first_of( "*?" );
+    if ( first_wildcard == std::string_view::npos ) {
+        kind = IndexKind::kExact;
+        key  = pattern;
+    }
+    else {
+        const std::string_view prefix = pattern.substr( 0, first_wildcard );
+        const std::string_view suffix = pattern.substr( pattern.find_last_of( "*?" ) + 1 );
+        if ( !prefix.empty() && prefix.size() >= suffix.size() ) {
+            kind = IndexKind::kPrefix;
+            key  = prefix;
+        }
+        else if ( !suffix.empty() ) {
+            kind = IndexKind::kSuffix;
+            key.assign( suffix.rbegin(), suffix.rend() );
+        }
+        else {
+            // 首尾都是通配符，取中间最长的字面量片段
+            std::string_view longest;
+            for ( auto run : StringUtil::SplitView( pattern, "*?", true, true ) ) {
+                if ( run.size() > longest.size() ) {
+                    longest = run;
+                }
+            }
+            if ( !longest.empty() ) {
+                kind = IndexKind::kSubstring;
+                key  = longest.substr( 0, kMaxIndexedLiteral );
+            }
+        }
+    }
+
+    auto             iter = entries_.emplace( id, Entry{ WildcardPattern( pattern ), kind, std::move( key ) } ).first;
+    std::string_view view = iter->second.key;
+    switch ( kind ) {
+        case IndexKind::kExact:
+            exact_[view].push_back( id );
+            break;
+        case IndexKind::kPrefix:
+            Insert( prefix_trie_, view, id );
+            break;
+        case IndexKind::kSuffix:
+            Insert( suffix_trie_, view, id );
+            break;
+        case IndexKind::kSubstring:
+            substrings_[view].push_back( id );
+            ++substring_lengths_[view.size()];
+            break;
+        case IndexKind::kUnindexed:
+            unindexed_.push_back( id );
+            break;
+    }
+    return id;
+}
+
+bool GlobSet::Remove( size_t id ) {
+    auto iter = entries_.find( id );
+    if ( iter == entries_.end() ) {
+        return false;
+    }
+
+    const std::string_view view = iter->second.key;
+    switch ( iter->second.kind ) {
+        case IndexKind::kExact:
+            EraseFromBucket( exact_, view, id );
+            break;
+        case IndexKind::kPrefix:
+            Erase( prefix_trie_, view, id );
+            break;
+        case IndexKind::kSuffix:
+            Erase( suffix_trie_, view, id );
+            break;
+        case IndexKind::kSubstring: {
+            EraseFromBucket( substrings_, view, id );
+            auto length = substring_lengths_.find( view.size() );
+            if ( --length->second == 0 ) {
+                substring_lengths_.erase( length );
+            }
+            break;
+        }
+        case IndexKind::kUnindexed:
+            EraseId( unindexed_, id );
+            break;
+    }
+    // 索引中的键引用了entry内的字符串，必须最后删除entry
+    entries_.erase( iter );
+    return true;
+}
+
+void GlobSet::EraseFromBucket( BucketMap &buckets, std::string_view key, size_t id ) {
+    auto bucket = buckets.find( key );
+    EraseId( bucket->second, id );
+    if ( bucket->second.empty() ) {
+        buckets.erase( bucket );
+        return;
+    }
+    // 桶的键可能引用即将删除的entry，改为引用桶中仍存在的模式的字符串
+    if ( bucket->first.data() == key.data() ) {
+        auto node  = buckets.extract( bucket );
+        node.key() = entries_.at( node.mapped().front() ).key;
+        buckets.insert( std::move( node ) );
+    }
+}
+
+void GlobSet::Clear() {
+    exact_.clear();
+    prefix_trie_ = Trie{};
+    suffix_trie_ = Trie{};
+    substrings_.clear();
+    substring_lengths_.clear();
+    unindexed_.clear();
+    entries_.clear();
+}
+
+template <typename Func>
+bool GlobSet::ForEachCandidate( std::string_view str, Func &&func ) const {
+    auto visit = [&]( const std::vector<size_t> &ids ) {
+        for ( const size_t id : ids ) {
+            if ( !func( id ) ) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if ( auto iter = exact_.find( str ); iter != exact_.end() && !visit( iter->second ) ) {
+        return false;
+    }
+
+    // 正向走前缀树，途经节点上的模式前缀都与输入相符
+    size_t node = 0;
+    for ( size_t i = 0; i < str.size(); ++i ) {
+        auto iter = prefix_trie_.nodes[node].children.find( static_cast<unsigned char>( str[i] ) );
+        if ( iter == prefix_trie_.nodes[node].children.end() ) {
+            break;
+        }
+        node = iter->second;
+        if ( !visit( prefix_trie_.nodes[node].ids ) ) {
+            return false;
+        }
+    }
+
+    // 反向走后缀树
+    node = 0;
+    for ( size_t i = str.size(); i > 0; --i ) {
+        auto iter = suffix_trie_.nodes[node].children.find( static_cast<unsigned char>( str[i - 1] ) );
+        if ( iter == suffix_trie_.nodes[node].children.end() ) {
+            break;
+        }
+        node = iter->second;
+        if ( !visit( suffix_trie_.nodes[node].ids ) ) {
+            return false;
+        }
+    }
+
+    // 按已登记的片段长度枚举输入子串
+    for ( const auto &[length, count] : substring_lengths_ ) {
+        if ( length > str.size() ) {
+            break;
+        }
+        for ( size_t i = 0; i + length <= str.size(); ++i ) {
+            auto iter = substrings_.find( str.substr( i, length ) );
+            if ( iter != substrings_.end() && !visit( iter->second ) ) {
+                return false;
+            }
+        }
+    }
+
+    return visit( unindexed_ );
+}
+
+std::vector<size_t> GlobSet::Match( std::string_view str ) const {
+    std::vector<size_t> ids;
+    Match( str, ids );
+    return ids;
+}
+
+void GlobSet::Match( std::string_view str, std::vector<size_t> &ids ) const {
+    ids.clear();
+    ForEachCandidate( str, [&]( size_t id ) {
+        if ( entries_.at( id ).pattern.Match( str ) ) {
+            ids.push_back( id );
+        }
+        return true;
+    } );
+    // 同一子串片段可能在输入中出现多次，去重
+    std::sort( ids.begin(), ids.end() );
+    ids.erase( std::unique( ids.begin(), ids.end() ), ids.end() );
+}
+
+bool GlobSet::MatchAny( std::string_view str ) const {
+    bool matched = false;
+    ForEachCandidate( str, [&]( size_t id ) {
+        matched = entries_.at( id ).pattern.Match( str );
+        return !matched;
+    } );
+    return matched;
+}
+
+}  // namespace utils
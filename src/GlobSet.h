@@ -0,0 +1,135 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Macros.h"
+#include "StringUtil.h"
+
+namespace utils {
+
+/**
+ * @brief 通配符模式集合，一次查询返回所有匹配的模式编号
+ *
+ * 模式语义与 StringUtil::WildcardMatch 相同（支持 * 和 ?）。
+ * 添加模式时按其字面量特征放入不同索引，查询时只校验被索引命中的候选模式：
+ *   - 不含通配符的模式：哈希表精确查找
+ *   - 有字面量前缀的模式（如 "api-v1-*"）：前缀字典树，沿输入正向走一遍
+ *   - 有字面量后缀的模式（如 "*.log"）：后缀字典树，沿输入反向走一遍
+ *   - 首尾均为通配符的模式（如 "*error*"）：以其必需的字面量片段建立子串索引，
+ *     查询时按已登记的片段长度枚举输入子串查表
+ *   - 没有任何字面量的模式（如 "*"、"???"）：直接校验
+ * 查询开销取决于输入长度和候选数量，与模式总数无关。支持增量添加和删除，无需重建。
+ *
+ * @note 非线程安全；并发查询需要外部保证期间没有添加/删除操作
+ *
+ * @code{.cpp}
+ *   GlobSet globs;
+ *   auto id_log = globs.Add( "*.log" );
+ *   auto id_api = globs.Add( "api-*" );
+ *   auto ids    = globs.Match( "api-app.log" );
+ *   // ids = {id_log, id_api}
+ *
+ *   globs.Remove( id_log );
+ *   ids = globs.Match( "api-app.log" );
+ *   // ids = {id_api}
+ * @endcode
+ */
+class GlobSet {
+public:
+    GlobSet() = default;
+    // 索引的键引用 entries_ 中的字符串，复制后会指向源对象；移动时哈希表节点地址不变，可以安全移动
+    DISABLE_COPY( GlobSet )
+    GlobSet( GlobSet && )            = default;
+    GlobSet &operator=( GlobSet && ) = default;
+
+    /**
+     * @brief 添加一个模式
+     * @param pattern 通配符模式
+     * @return 模式编号（单调递增，删除后不复用）
+     */
+    size_t Add( std::string_view pattern );
+    /**
+     * @brief 删除一个模式
+     * @param id Add 返回的编号
+     * @return 编号存在并被删除时返回 true
+     */
+    bool Remove( size_t id );
+    /// 清空所有模式
+    void Clear();
+
+    /// 模式数量
+    [[nodiscard]] size_t Size() const noexcept { return entries_.size(); }
+    [[nodiscard]] bool   Empty() const noexcept { return entries_.empty(); }
+    /// 前缀、后缀字典树中正在使用的节点数（删除模式时回收不再需要的节点）
+    [[nodiscard]] size_t TrieNodeCount() const noexcept {
+        return prefix_trie_.nodes.size() - prefix_trie_.free.size() + suffix_trie_.nodes.size() -
+               suffix_trie_.free.size();
+    }
+
+    /**
+     * @brief 查询匹配的所有模式
+     * @param str 待匹配字符串
+     * @return 匹配的模式编号（升序）
+     */
+    [[nodiscard]] std::vector<size_t> Match( std::string_view str ) const;
+    /**
+     * @brief 查询匹配的所有模式，写入调用方复用的缓冲区
+     * @param str 待匹配字符串
+     * @param ids [out] 匹配的模式编号（升序，会先清空）
+     */
+    void Match( std::string_view str, std::vector<size_t> &ids ) const;
+    /// 是否至少有一个模式匹配
+    [[nodiscard]] bool MatchAny( std::string_view str ) const;
+
+private:
+    enum class IndexKind { kExact, kPrefix, kSuffix, kSubstring, kUnindexed };
+
+    struct Entry {
+        WildcardPattern pattern;
+        IndexKind       kind;
+        std::string     key;  ///< 索引使用的字面量（后缀已反转）
+    };
+
+    /// 字典树节点，ids 为字面量恰好终止于此节点的模式
+    struct TrieNode {
+        std::map<unsigned char, size_t> children;
+        std::vector<size_t>             ids;
+    };
+
+    /// 字典树，nodes[0] 为根；删除后空出的节点放入 free 供之后插入复用
+    struct Trie {
+        std::vector<TrieNode> nodes{ 1 };
+        std::vector<size_t>   free;
+    };
+
+    static void Insert( Trie &trie, std::string_view key, size_t id );
+    /// 删除编号，并自下而上回收既无子节点也无编号的节点
+    static void Erase( Trie &trie, std::string_view key, size_t id );
+    static void EraseId( std::vector<size_t> &ids, size_t id );
+
+    /// 字面量 -> 模式编号，键引用桶中某个 Entry::key
+    using BucketMap = std::unordered_map<std::string_view, std::vector<size_t>>;
+    /// 从桶中删除编号；桶非空且键引用的正是被删除模式时，把键改为引用剩余的模式
+    void EraseFromBucket( BucketMap &buckets, std::string_view key, size_t id );
+
+    /// 收集候选模式，返回 false 表示回调要求提前结束
+    template <typename Func>
+    bool ForEachCandidate( std::string_view str, Func &&func ) const;
+
+    /// 子串索引中登记的最长片段长度，超出部分截断（截断后仍是必要条件）
+    static constexpr size_t kMaxIndexedLiteral = 8;
+
+    size_t                            next_id_ = 0;
+    std::unordered_map<size_t, Entry> entries_;
+    BucketMap                         exact_;
+    Trie                              prefix_trie_;
+    Trie                              suffix_trie_;
+    BucketMap                         substrings_;
+    std::map<size_t, size_t>          substring_lengths_;  ///< 片段长度 -> 模式数量
+    std::vector<size_t>               unindexed_;
+};
+
+}  // namespace utils
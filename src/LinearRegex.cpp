@@ -0,0 +1,998 @@
+#include "LinearRegex.h"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace utils {
+
+namespace {
+
+enum class Op : uint8_t {
+    kByte,    ///< 消耗一个属于 classes_[x] 的字节
+    kSplit,   ///< 分叉，优先尝试 x，其次 y
+    kJmp,     ///< 跳转到 x
+    kSave,    ///< 记录当前位置到捕获槽 x
+    kAssert,  ///< 零宽断言，类型为 AssertKind(x)
+    kMatch,
+};
+
+enum class AssertKind : uint8_t { kBeginText, kEndText, kWordBoundary, kNotWordBoundary };
+
+constexpr size_t   kInfinite        = SIZE_MAX;
+constexpr size_t   kMaxRepeat       = 1000;
+constexpr size_t   kMaxInstructions = 100000;
+constexpr size_t   kMaxNesting      = 1000;  ///< 分组最大嵌套层数，解析、编译和释放语法树都按层递归
+constexpr uint32_t kNoSlot          = UINT32_MAX;
+
+struct ParseError {
+    std::string message;
+};
+
+bool IsWordByte( unsigned char c ) noexcept {
+    return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) || c == '_';
+}
+
+/// at 之前的字节是否为单词字符；at 为0时参考 prev_byte（-1 表示没有前一字节）
+bool PrevIsWord( std::string_view text, int prev_byte, size_t at ) noexcept {
+    if ( at > 0 ) {
+        return IsWordByte( static_cast<unsigned char>( text[at - 1] ) );
+    }
+    return prev_byte >= 0 && IsWordByte( static_cast<unsigned char>( prev_byte ) );
+}
+
+int HexValue( char c ) noexcept {
+    if ( c >= '0' && c <= '9' ) {
+        return c - '0';
+    }
+    if ( c >= 'a' && c <= 'f' ) {
+        return c - 'a' + 10;
+    }
+    if ( c >= 'A' && c <= 'F' ) {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+CharSet Single( unsigned char c ) noexcept {
+    return CharSet::Range( c, c );
+}
+
+CharSet Complement( const CharSet &set ) {
+    std::string members;
+    for ( int c = 0; c < 256; ++c ) {
+        if ( !set.Contains( static_cast<char>( c ) ) ) {
+            members.push_back( static_cast<char>( c ) );
+        }
+    }
+    return CharSet( members );
+}
+
+const CharSet &DigitSet() {
+    static const CharSet set = CharSet::Range( '0', '9' );
+    return set;
+}
+
+const CharSet &WordSet() {
+    static const CharSet set =
+        CharSet::Range( 'a', 'z' ) | CharSet::Range( 'A', 'Z' ) | CharSet::Range( '0', '9' ) | CharSet( "_" );
+    return set;
+}
+
+const CharSet &SpaceSet() {
+    static const CharSet set( " \t\n\v\f\r" );
+    return set;
+}
+
+/// 语法树节点
+struct Node {
+    enum class Kind { kEmpty, kClass, kConcat, kAlternate, kRepeat, kGroup, kAssert };
+
+    explicit Node( Kind kind ) : kind( kind ) {}
+
+    Kind                               kind;
+    uint32_t                           cls = 0;  ///< kClass: 字符集编号
+    std::vector<std::unique_ptr<Node>> children;
+    size_t                             min    = 0;  ///< kRepeat
+    size_t                             max    = 0;  ///< kRepeat，kInfinite 表示无上限
+    bool                               greedy = true;
+    int                                group  = -1;  ///< kGroup: 捕获组编号，-1 为非捕获组
+    AssertKind                         assertion = AssertKind::kBeginText;
+};
+
+using NodePtr = std::unique_ptr<Node>;
+
+/// 递归下降解析器，出错时抛出 ParseError
+class Parser {
+public:
+    Parser( std::string_view pattern, std::vector<CharSet> &classes ) : pattern_( pattern ), classes_( classes ) {}
+
+    NodePtr Parse() {
+        NodePtr root = ParseAlternate();
+        if ( pos_ < pattern_.size() ) {
+            Fail( "unmatched ')'" );
+        }
+        return root;
+    }
+
+    size_t GroupCount() const noexcept { return group_count_; }
+
+private:
+    [[noreturn]] void Fail( const std::string &message ) const {
+        throw ParseError{ message + " at position " + std::to_string( pos_ ) };
+    }
+
+    bool AtEnd() const noexcept { return pos_ >= pattern_.size(); }
+    char Peek() const noexcept { return pattern_[pos_]; }
+
+    NodePtr MakeClass( const CharSet &set ) {
+        auto node = std::make_unique<Node>( Node::Kind::kClass );
+        node->cls = static_cast<uint32_t>( classes_.size() );
+        classes_.push_back( set );
+        return node;
+    }
+
+    NodePtr MakeAssert( AssertKind kind ) {
+        auto node       = std::make_unique<Node>( Node::Kind::kAssert );
+        node->assertion = kind;
+        return node;
+    }
+
+    NodePtr ParseAlternate() {
+        NodePtr first = ParseConcat();
+        if ( AtEnd() || Peek() != '|' ) {
+            return first;
+        }
+        auto node = std::make_unique<Node>( Node::Kind::kAlternate );
+        node->children.push_back( std::move( first ) );
+        while ( !AtEnd() && Peek() == '|' ) {
+            ++pos_;
+            node->children.push_back( ParseConcat() );
+        }
+        return node;
+    }
+
+    NodePtr ParseConcat() {
+        auto node = std::make_unique<Node>( Node::Kind::kConcat );
+        while ( !AtEnd() && Peek() != '|' && Peek() != ')' ) {
+            node->children.push_back( ParseQuantifier( ParseAtom() ) );
+        }
+        if ( node->children.empty() ) {
+            return std::make_unique<Node>( Node::Kind::kEmpty );
+        }
+        if ( node->children.size() == 1 ) {
+            return std::move( node->children.front() );
+        }
+        return node;
+    }
+
+    NodePtr ParseAtom() {
+        const char c = pattern_[pos_++];
+        switch ( c ) {
+            case '(': {
+                if ( ++depth_ > kMaxNesting ) {
+                    Fail( "groups nested too deeply" );
+                }
+                int group = -1;
+                if ( !AtEnd() && Peek() == '?' ) {
+                    if ( pos_ + 1 >= pattern_.size() || pattern_[pos_ + 1] != ':' ) {
+                        Fail( "lookaround is not supported" );
+                    }
+                    pos_ += 2;
+                }
+                else {
+                    group = static_cast<int>( group_count_++ );
+                }
+                auto node   = std::make_unique<Node>( Node::Kind::kGroup );
+                node->group = group;
+                node->children.push_back( ParseAlternate() );
+                if ( AtEnd() || Peek() != ')' ) {
+                    Fail( "missing ')'" );
+                }
+                ++pos_;
+                --depth_;
+                return node;
+            }
+            case '[':
+                return ParseClass();
+            case '.':
+                return MakeClass( Complement( CharSet( "\n\r" ) ) );
+            case '^':
+                return MakeAssert( AssertKind::kBeginText );
+            case '$':
+                return MakeAssert( AssertKind::kEndText );
+            case '\\':
+                return ParseEscape();
+            case '*':
+            case '+':
+            case '?':
+                --pos_;
+                Fail( "nothing to repeat" );
+            case '{': {
+                size_t min = 0, max = 0, end = pos_ - 1;
+                if ( ParseBraces( end, min, max ) ) {
+                    --pos_;
+                    Fail( "nothing to repeat" );
+                }
+                return MakeClass( Single( '{' ) );
+            }
+            default:
+                return MakeClass( Single( static_cast<unsigned char>( c ) ) );
+        }
+    }
+
+    /// 解析 {n} {n,} {n,m}，成功时 pos 移到 '}' 之后
+    bool ParseBraces( size_t &pos, size_t &min, size_t &max ) const {
+        size_t p = pos + 1;
+        auto   read_number = [&]( size_t &value ) {
+            const size_t start = p;
+            value              = 0;
+            while ( p < pattern_.size() && pattern_[p] >= '0' && pattern_[p] <= '9' ) {
+                value = std::min( value * 10 + static_cast<size_t>( pattern_[p] - '0' ), kMaxRepeat + 1 );
+                ++p;
+            }
+            return p > start;
+        };
+        if ( !read_number( min ) ) {
+            return false;
+        }
+        max = min;
+        if ( p < pattern_.size() && pattern_[p] == ',' ) {
+            ++p;
+            if ( !read_number( max ) ) {
+                max = kInfinite;
+            }
+        }
+        if ( p >= pattern_.size() || pattern_[p] != '}' ) {
+            return false;
+        }
+        pos = p + 1;
+        return true;
+    }
+
+    NodePtr ParseQuantifier( NodePtr atom ) {
+        if ( AtEnd() ) {
+            return atom;
+        }
+        size_t min = 0, max = 0;
+        switch ( Peek() ) {
+            case '*':
+                min = 0, max = kInfinite, ++pos_;
+                break;
+            case '+':
+                min = 1, max = kInfinite, ++pos_;
+                break;
+            case '?':
+                min = 0, max = 1, ++pos_;
+                break;
+            case '{':
+                if ( !ParseBraces( pos_, min, max ) ) {
+                    return atom;
+                }
+                break;
+            default:
+                return atom;
+        }
+        if ( atom->kind == Node::Kind::kAssert ) {
+            Fail( "nothing to repeat" );
+        }
+        if ( min > kMaxRepeat || ( max != kInfinite && max > kMaxRepeat ) ) {
+            Fail( "repetition count too large" );
+        }
+        if ( max < min ) {
+            Fail( "bad repetition range" );
+        }
+
+        auto node    = std::make_unique<Node>( Node::Kind::kRepeat );
+        node->min    = min;
+        node->max    = max;
+        node->greedy = true;
+        if ( !AtEnd() && Peek() == '?' ) {
+            node->greedy = false;
+            ++pos_;
+        }
+        node->children.push_back( std::move( atom ) );
+        return node;
+    }
+
+    /// 字符类内外通用的转义；返回 true 表示转义代表一个字符集合（写入set），否则为单个字节（写入byte）
+    bool ParseCommonEscape( CharSet &set, unsigned char &byte ) {
+        if ( AtEnd() ) {
+            Fail( "trailing backslash" );
+        }
+        const char c = pattern_[pos_++];
+        switch ( c ) {
+            case 'd':
+                set = DigitSet();
+                return true;
+            case 'D':
+                set = Complement( DigitSet() );
+                return true;
+            case 'w':
+                set = WordSet();
+                return true;
+            case 'W':
+                set = Complement( WordSet() );
+                return true;
+            case 's':
+                set = SpaceSet();
+                return true;
+            case 'S':
+                set = Complement( SpaceSet() );
+                return true;
+            case 'n':
+                byte = '\n';
+                return false;
+            case 'r':
+                byte = '\r';
+                return false;
+            case 't':
+                byte = '\t';
+                return false;
+            case 'f':
+                byte = '\f';
+                return false;
+            case 'v':
+                byte = '\v';
+                return false;
+            case '0':
+                byte = '\0';
+                return false;
+            case 'x': {
+                if ( pos_ + 2 > pattern_.size() || HexValue( pattern_[pos_] ) < 0 ||
+                     HexValue( pattern_[pos_ + 1] ) < 0 ) {
+                    Fail( "invalid \\x escape" );
+                }
+                byte = static_cast<unsigned char>( HexValue( pattern_[pos_] ) * 16 + HexValue( pattern_[pos_ + 1] ) );
+                pos_ += 2;
+                return false;
+            }
+            default:
+                if ( c >= '1' && c <= '9' ) {
+                    Fail( "backreferences are not supported" );
+                }
+                if ( IsWordByte( static_cast<unsigned char>( c ) ) ) {
+                    Fail( std::string( "unsupported escape \\" ) + c );
+                }
+                byte = static_cast<unsigned char>( c );
+                return false;
+        }
+    }
+
+    NodePtr ParseEscape() {
+        if ( !AtEnd() && ( Peek() == 'b' || Peek() == 'B' ) ) {
+            return MakeAssert( pattern_[pos_++] == 'b' ? AssertKind::kWordBoundary : AssertKind::kNotWordBoundary );
+        }
+        CharSet       set;
+        unsigned char byte = 0;
+        if ( ParseCommonEscape( set, byte ) ) {
+            return MakeClass( set );
+        }
+        return MakeClass( Single( byte ) );
+    }
+
+    /// 解析字符类中的一个成员；返回 true 表示集合，否则为单个字节
+    bool ParseClassAtom( CharSet &set, unsigned char &byte ) {
+        const char c = pattern_[pos_++];
+        if ( c != '\\' ) {
+            byte = static_cast<unsigned char>( c );
+            return false;
+        }
+        // 字符类中 \b 表示退格
+        if ( !AtEnd() && Peek() == 'b' ) {
+            ++pos_;
+            byte = '\b';
+            return false;
+        }
+        return ParseCommonEscape( set, byte );
+    }
+
+    NodePtr ParseClass() {
+        bool negate = false;
+        if ( !AtEnd() && Peek() == '^' ) {
+            negate = true;
+            ++pos_;
+        }
+
+        CharSet members;
+        while ( true ) {
+            if ( AtEnd() ) {
+                Fail( "missing ']'" );
+            }
+            if ( Peek() == ']' ) {
+                ++pos_;
+                break;
+            }
+
+            CharSet       set;
+            unsigned char low = 0;
+            if ( ParseClassAtom( set, low ) ) {
+                members = members | set;
+                continue;
+            }
+            if ( pos_ + 1 < pattern_.size() && Peek() == '-' && pattern_[pos_ + 1] != ']' ) {
+                ++pos_;
+                unsigned char high = 0;
+                if ( ParseClassAtom( set, high ) || high < low ) {
+                    Fail( "bad character class range" );
+                }
+                members = members | CharSet::Range( low, high );
+                continue;
+            }
+            members = members | Single( low );
+        }
+        return MakeClass( negate ? Complement( members ) : members );
+    }
+
+    std::string_view      pattern_;
+    std::vector<CharSet> &classes_;
+    size_t                pos_         = 0;
+    size_t                group_count_ = 1;
+    size_t                depth_       = 0;  ///< 当前分组嵌套层数
+};
+
+/// 稀疏集合，插入、查询、清空均为O(1)
+class SparseSet {
+public:
+    explicit SparseSet( size_t capacity ) : sparse_( capacity ), dense_( capacity ) {}
+
+    bool Contains( uint32_t value ) const noexcept {
+        const uint32_t index = sparse_[value];
+        return index < size_ && dense_[index] == value;
+    }
+    void Insert( uint32_t value ) noexcept {
+        sparse_[value] = size_;
+        dense_[size_++] = value;
+    }
+    void Clear() noexcept { size_ = 0; }
+
+private:
+    std::vector<uint32_t> sparse_;
+    std::vector<uint32_t> dense_;
+    uint32_t              size_ = 0;
+};
+
+}  // namespace
+
+struct LinearRegex::Inst {
+    Op       op;
+    uint32_t x = 0;
+    uint32_t y = 0;
+};
+
+/// 把语法树编译为 Pike VM 指令
+class LinearRegex::Compiler {
+public:
+    explicit Compiler( std::vector<Inst> &program ) : program_( program ) {}
+
+    uint32_t Emit( Op op, uint32_t x = 0, uint32_t y = 0 ) {
+        if ( program_.size() >= kMaxInstructions ) {
+            throw ParseError{ "regex too large" };
+        }
+        program_.push_back( { op, x, y } );
+        return static_cast<uint32_t>( program_.size() - 1 );
+    }
+
+    uint32_t Here() const noexcept { return static_cast<uint32_t>( program_.size() ); }
+
+    void Compile( const Node &node ) {
+        switch ( node.kind ) {
+            case Node::Kind::kEmpty:
+                break;
+            case Node::Kind::kClass:
+                Emit( Op::kByte, node.cls );
+                break;
+            case Node::Kind::kAssert:
+                Emit( Op::kAssert, static_cast<uint32_t>( node.assertion ) );
+                break;
+            case Node::Kind::kConcat:
+                for ( const auto &child : node.children ) {
+                    Compile( *child );
+                }
+                break;
+            case Node::Kind::kGroup:
+                if ( node.group >= 0 ) {
+                    Emit( Op::kSave, static_cast<uint32_t>( node.group * 2 ) );
+                }
+                Compile( *node.children.front() );
+                if ( node.group >= 0 ) {
+                    Emit( Op::kSave, static_cast<uint32_t>( node.group * 2 + 1 ) );
+                }
+                break;
+            case Node::Kind::kAlternate: {
+                std::vector<uint32_t> jumps;
+                for ( size_t i = 0; i + 1 < node.children.size(); ++i ) {
+                    const uint32_t split = Emit( Op::kSplit );
+                    program_[split].x    = split + 1;
+                    Compile( *node.children[i] );
+                    jumps.push_back( Emit( Op::kJmp ) );
+                    program_[split].y = Here();
+                }
+                Compile( *node.children.back() );
+                for ( const uint32_t jump : jumps ) {
+                    program_[jump].x = Here();
+                }
+                break;
+            }
+            case Node::Kind::kRepeat:
+                CompileRepeat( node );
+                break;
+        }
+    }
+
+private:
+    void SetSplit( uint32_t split, uint32_t body, uint32_t out, bool greedy ) {
+        program_[split].x = greedy ? body : out;
+        program_[split].y = greedy ? out : body;
+    }
+
+    void CompileRepeat( const Node &node ) {
+        const Node &child = *node.children.front();
+        for ( size_t i = 0; i < node.min; ++i ) {
+            Compile( child );
+        }
+        if ( node.max == kInfinite ) {
+            // L: split body, out; body; jmp L; out:
+            const uint32_t split = Emit( Op::kSplit );
+            Compile( child );
+            Emit( Op::kJmp, split );
+            SetSplit( split, split + 1, Here(), node.greedy );
+            return;
+        }
+        // 可选部分展开为嵌套的 (x(x)?)?，任一处跳过即跳到末尾
+        std::vector<uint32_t> splits;
+        for ( size_t i = node.min; i < node.max; ++i ) {
+            splits.push_back( Emit( Op::kSplit ) );
+            Compile( child );
+        }
+        for ( const uint32_t split : splits ) {
+            SetSplit( split, split + 1, Here(), node.greedy );
+        }
+    }
+
+    std::vector<Inst> &program_;
+};
+
+/**
+ * @brief 惰性构造的DFA，只回答“从某位置起是否存在匹配”
+ *
+ * 状态由NFA指令集合（消耗字节后到达的位置，尚未做ε闭包）加上下文标志组成，
+ * 断言在转移时根据前一字节和下一字节求值，因此 \b、^、$ 也能在DFA中处理。
+ * 每个状态的256个转移在首次经过时才计算。
+ */
+class LinearRegex::Dfa {
+public:
+    explicit Dfa( const LinearRegex &regex ) : regex_( regex ), visited_( regex.program_.size() ) {}
+
+    /// 返回值含义见 LinearRegex::ScanDfa
+    int Scan( const Input &input, size_t pos, size_t &idle ) {
+        if ( failed_ ) {
+            return -1;
+        }
+        const std::string_view text      = input.text;
+        const bool             prev_word = PrevIsWord( text, input.prev_byte, pos );
+        const bool             at_begin  = pos == 0 && input.prev_byte < 0;
+        int32_t               &start     = start_[prev_word][at_begin];
+        if ( start == kUnknown ) {
+            start = AddState( { 0 }, prev_word, at_begin );
+            if ( start == kUnknown ) {
+                return -1;
+            }
+        }
+
+        int32_t state = start;
+        idle          = pos;
+        for ( size_t i = pos; i < text.size(); ++i ) {
+            if ( states_[state].idle ) {
+                idle = i;
+            }
+            const size_t index = static_cast<size_t>( state ) * 256 + static_cast<unsigned char>( text[i] );
+            if ( transitions_[index] == kUnknown ) {
+                const int32_t next = ComputeTransition( state, static_cast<unsigned char>( text[i] ) );
+                if ( next == kUnknown ) {
+                    return -1;
+                }
+                transitions_[index] = next;
+            }
+            if ( transitions_[index] == kMatchHere ) {
+                return 1;
+            }
+            state = transitions_[index];
+        }
+
+        State &last = states_[state];
+        if ( last.idle ) {
+            idle = text.size();
+        }
+        // 末尾的断言依赖后续数据，留给调用方补充数据后再判断
+        if ( !input.complete ) {
+            return 0;
+        }
+        if ( last.match_at_end < 0 ) {
+            last.match_at_end = Closure( last, false, true ) ? 1 : 0;
+        }
+        return last.match_at_end;
+    }
+
+private:
+    static constexpr int32_t kUnknown   = -1;
+    static constexpr int32_t kMatchHere = -2;  ///< 消耗该字节之前已经匹配
+    static constexpr size_t  kMaxStates = 1024;
+
+    struct State {
+        std::vector<uint32_t> kernel;
+        bool                  prev_word;
+        bool                  at_begin;
+        bool                  idle;  ///< 只剩下起始指令，即没有进行中的候选匹配
+        int8_t                match_at_end = -1;
+    };
+
+    /// 以给定上下文求ε闭包，消耗字节的指令写入 consuming_，返回闭包中是否有匹配指令
+    bool Closure( const State &state, bool next_word, bool at_end ) {
+        const auto &program = regex_.program_;
+        bool        matched = false;
+        visited_.Clear();
+        consuming_.clear();
+        stack_.assign( state.kernel.rbegin(), state.kernel.rend() );
+        while ( !stack_.empty() ) {
+            const uint32_t pc = stack_.back();
+            stack_.pop_back();
+            if ( visited_.Contains( pc ) ) {
+                continue;
+            }
+            visited_.Insert( pc );
+            const Inst &inst = program[pc];
+            switch ( inst.op ) {
+                case Op::kByte:
+                    consuming_.push_back( pc );
+                    break;
+                case Op::kMatch:
+                    matched = true;
+                    break;
+                case Op::kJmp:
+                    stack_.push_back( inst.x );
+                    break;
+                case Op::kSplit:
+                    stack_.push_back( inst.y );
+                    stack_.push_back( inst.x );
+                    break;
+                case Op::kSave:
+                    stack_.push_back( pc + 1 );
+                    break;
+                case Op::kAssert: {
+                    bool holds = false;
+                    switch ( static_cast<AssertKind>( inst.x ) ) {
+                        case AssertKind::kBeginText:
+                            holds = state.at_begin;
+                            break;
+                        case AssertKind::kEndText:
+                            holds = at_end;
+                            break;
+                        case AssertKind::kWordBoundary:
+                            holds = state.prev_word != next_word;
+                            break;
+                        case AssertKind::kNotWordBoundary:
+                            holds = state.prev_word == next_word;
+                            break;
+                    }
+                    if ( holds ) {
+                        stack_.push_back( pc + 1 );
+                    }
+                    break;
+                }
+            }
+        }
+        return matched;
+    }
+
+    int32_t ComputeTransition( int32_t from, unsigned char c ) {
+        if ( Closure( states_[from], IsWordByte( c ), false ) ) {
+            return kMatchHere;
+        }
+        // 非锚定查找：每个位置都可能开始新的匹配
+        std::vector<uint32_t> kernel{ 0 };
+        for ( const uint32_t pc : consuming_ ) {
+            if ( regex_.classes_[regex_.program_[pc].x].Contains( static_cast<char>( c ) ) ) {
+                kernel.push_back( pc + 1 );
+            }
+        }
+        return AddState( std::move( kernel ), IsWordByte( c ), false );
+    }
+
+    int32_t AddState( std::vector<uint32_t> kernel, bool prev_word, bool at_begin ) {
+        std::sort( kernel.begin(), kernel.end() );
+        kernel.erase( std::unique( kernel.begin(), kernel.end() ), kernel.end() );
+
+        std::string key( reinterpret_cast<const char *>( kernel.data() ), kernel.size() * sizeof( uint32_t ) );
+        key.push_back( static_cast<char>( ( prev_word ? 1 : 0 ) | ( at_begin ? 2 : 0 ) ) );
+        auto iter = index_.find( key );
+        if ( iter != index_.end() ) {
+            return iter->second;
+        }
+        if ( states_.size() >= kMaxStates ) {
+            failed_ = true;
+            return kUnknown;
+        }
+
+        const auto id = static_cast<int32_t>( states_.size() );
+        const bool idle = kernel.size() == 1;
+        states_.push_back( { std::move( kernel ), prev_word, at_begin, idle } );
+        transitions_.resize( transitions_.size() + 256, kUnknown );
+        index_.emplace( std::move( key ), id );
+        return id;
+    }
+
+    const LinearRegex                       &regex_;
+    std::vector<State>                       states_;
+    std::vector<int32_t>                     transitions_;  ///< [state * 256 + byte]
+    std::unordered_map<std::string, int32_t> index_;
+    int32_t                                  start_[2][2] = { { kUnknown, kUnknown }, { kUnknown, kUnknown } };
+    bool                                     failed_      = false;
+    SparseSet                                visited_;
+    std::vector<uint32_t>                    stack_;
+    std::vector<uint32_t>                    consuming_;
+};
+
+LinearRegex::LinearRegex() = default;
+
+LinearRegex::~LinearRegex() = default;
+
+std::unique_ptr<LinearRegex> LinearRegex::Compile( std::string_view pattern, std::string *error_msg ) {
+    std::unique_ptr<LinearRegex> regex( new LinearRegex );
+    try {
+        Parser  parser( pattern, regex->classes_ );
+        NodePtr root        = parser.Parse();
+        regex->group_count_ = parser.GroupCount();
+
+        Compiler compiler( regex->program_ );
+        compiler.Emit( Op::kSave, 0 );
+        compiler.Compile( *root );
+        compiler.Emit( Op::kSave, 1 );
+        compiler.Emit( Op::kMatch );
+        regex->ComputeFirstBytes();
+    }
+    catch ( const ParseError &e ) {
+        if ( error_msg ) {
+            *error_msg = e.message;
+        }
+        return nullptr;
+    }
+    return regex;
+}
+
+void LinearRegex::ComputeFirstBytes() {
+    SparseSet             visited( program_.size() );
+    std::vector<uint32_t> stack{ 0 };
+    use_first_bytes_ = true;
+    while ( !stack.empty() ) {
+        const uint32_t pc = stack.back();
+        stack.pop_back();
+        if ( visited.Contains( pc ) ) {
+            continue;
+        }
+        visited.Insert( pc );
+        const Inst &inst = program_[pc];
+        switch ( inst.op ) {
+            case Op::kByte:
+                first_bytes_ = first_bytes_ | classes_[inst.x];
+                break;
+            case Op::kJmp:
+                stack.push_back( inst.x );
+                break;
+            case Op::kSplit:
+                stack.push_back( inst.x );
+                stack.push_back( inst.y );
+                break;
+            case Op::kSave:
+                stack.push_back( pc + 1 );
+                break;
+            case Op::kAssert:
+            case Op::kMatch:
+                use_first_bytes_ = false;
+                return;
+        }
+    }
+}
+
+bool LinearRegex::Search( std::string_view text, size_t pos, std::vector<Span> &groups, bool not_empty ) const {
+    size_t keep_from = 0;
+    return SearchStream( text, pos, -1, true, groups, keep_from, not_empty ) == StreamResult::kMatch;
+}
+
+LinearRegex::StreamResult LinearRegex::SearchStream( std::string_view text, size_t pos, int prev_byte,
+                                                     bool complete, std::vector<Span> &groups, size_t &keep_from,
+                                                     bool not_empty ) const {
+    if ( pos > text.size() ) {
+        keep_from = text.size();
+        return complete ? StreamResult::kNoMatch : StreamResult::kNeedMore;
+    }
+
+    const Input input{ text, prev_byte, complete };
+    size_t      idle   = pos;
+    const int   result = ScanDfa( input, pos, idle );
+    if ( result == 0 ) {
+        keep_from = idle;
+        return complete ? StreamResult::kNoMatch : StreamResult::kNeedMore;
+    }
+    // DFA 不区分空匹配，只能排除不存在匹配的情况，not_empty 交由NFA处理
+    return RunNfa( input, pos, groups, keep_from, not_empty );
+}
+
+int LinearRegex::ScanDfa( const Input &input, size_t pos, size_t &idle ) const {
+    std::unique_ptr<Dfa> dfa;
+    {
+        std::lock_guard<std::mutex> lock( dfa_mutex_ );
+        if ( !dfa_pool_.empty() ) {
+            dfa = std::move( dfa_pool_.back() );
+            dfa_pool_.pop_back();
+        }
+    }
+    if ( !dfa ) {
+        dfa = std::make_unique<Dfa>( *this );
+    }
+    const int result = dfa->Scan( input, pos, idle );
+
+    std::lock_guard<std::mutex> lock( dfa_mutex_ );
+    dfa_pool_.push_back( std::move( dfa ) );
+    return result;
+}
+
+namespace {
+
+/// Pike VM 的线程列表，按优先级排列消耗字节的线程及其捕获槽
+struct ThreadList {
+    explicit ThreadList( size_t program_size ) : visited( program_size ) {}
+
+    void Clear() noexcept {
+        visited.Clear();
+        pcs.clear();
+        caps.clear();
+    }
+
+    SparseSet             visited;
+    std::vector<uint32_t> pcs;
+    std::vector<size_t>   caps;  ///< pcs.size() * 捕获槽数
+};
+
+struct StackEntry {
+    uint32_t pc;
+    uint32_t slot;   ///< 不为 kNoSlot 时表示恢复捕获槽
+    size_t   value;
+};
+
+}  // namespace
+
+LinearRegex::StreamResult LinearRegex::RunNfa( const Input &input, size_t pos, std::vector<Span> &groups,
+                                               size_t &keep_from, bool not_empty ) const {
+    const std::string_view text       = input.text;
+    const size_t           slot_count = group_count_ * 2;
+
+    ThreadList              clist( program_.size() );
+    ThreadList              nlist( program_.size() );
+    std::vector<size_t>     caps( slot_count );
+    std::vector<size_t>     matched_caps;
+    std::vector<StackEntry> stack;
+    bool                    matched = false;
+
+    auto assert_holds = [&]( AssertKind kind, size_t at ) {
+        // 输入未结束时末尾的断言无法确定，先假定成立；这些线程只用于计算 keep_from，结果不会被采用
+        if ( at == text.size() && !input.complete ) {
+            return true;
+        }
+        const bool prev_word = PrevIsWord( text, input.prev_byte, at );
+        const bool next_word = at < text.size() && IsWordByte( static_cast<unsigned char>( text[at] ) );
+        switch ( kind ) {
+            case AssertKind::kBeginText:
+                return at == 0 && input.prev_byte < 0;
+            case AssertKind::kEndText:
+                return at == text.size();
+            case AssertKind::kWordBoundary:
+                return prev_word != next_word;
+            case AssertKind::kNotWordBoundary:
+                return prev_word == next_word;
+        }
+        return false;
+    };
+
+    // 沿ε边按优先级展开线程；caps 在展开过程中被修改，返回前恢复原值
+    auto add_thread = [&]( ThreadList &list, uint32_t start_pc, size_t at ) {
+        stack.push_back( { start_pc, kNoSlot, 0 } );
+        while ( !stack.empty() ) {
+            const StackEntry entry = stack.back();
+            stack.pop_back();
+            if ( entry.slot != kNoSlot ) {
+                caps[entry.slot] = entry.value;
+                continue;
+            }
+            const uint32_t pc = entry.pc;
+            if ( list.visited.Contains( pc ) ) {
+                continue;
+            }
+            list.visited.Insert( pc );
+            const Inst &inst = program_[pc];
+            switch ( inst.op ) {
+                case Op::kByte:
+                case Op::kMatch:
+                    list.pcs.push_back( pc );
+                    list.caps.insert( list.caps.end(), caps.begin(), caps.end() );
+                    break;
+                case Op::kJmp:
+                    stack.push_back( { inst.x, kNoSlot, 0 } );
+                    break;
+                case Op::kSplit:
+                    stack.push_back( { inst.y, kNoSlot, 0 } );
+                    stack.push_back( { inst.x, kNoSlot, 0 } );
+                    break;
+                case Op::kSave:
+                    stack.push_back( { 0, inst.x, caps[inst.x] } );
+                    caps[inst.x] = at;
+                    stack.push_back( { pc + 1, kNoSlot, 0 } );
+                    break;
+                case Op::kAssert:
+                    if ( assert_holds( static_cast<AssertKind>( inst.x ), at ) ) {
+                        stack.push_back( { pc + 1, kNoSlot, 0 } );
+                    }
+                    break;
+            }
+        }
+    };
+
+    for ( size_t i = pos;; ++i ) {
+        if ( clist.pcs.empty() && matched ) {
+            break;
+        }
+        // 没有存活线程时，直接跳到下一个可能的起点
+        if ( clist.pcs.empty() && !matched && use_first_bytes_ ) {
+            i = std::min( first_bytes_.FindFirst( text, i ), text.size() );
+        }
+        if ( i == text.size() && !input.complete ) {
+            // 结果依赖后续数据：保留匹配及所有存活线程的起点
+            keep_from = matched ? matched_caps[0] : i;
+            for ( size_t t = 0; t < clist.pcs.size(); ++t ) {
+                keep_from = std::min( keep_from, clist.caps[t * slot_count] );
+            }
+            return StreamResult::kNeedMore;
+        }
+        // 已找到匹配后不再从新位置起步，只让优先级更高的线程继续
+        if ( !matched ) {
+            std::fill( caps.begin(), caps.end(), std::string_view::npos );
+            add_thread( clist, 0, i );
+        }
+
+        nlist.Clear();
+        for ( size_t t = 0; t < clist.pcs.size(); ++t ) {
+            const Inst   &inst        = program_[clist.pcs[t]];
+            const size_t *thread_caps = clist.caps.data() + t * slot_count;
+            if ( inst.op == Op::kMatch ) {
+                // 在pos处结束的匹配必然是从pos开始的空匹配，跳过它让优先级更低的线程继续
+                if ( not_empty && i == pos ) {
+                    continue;
+                }
+                matched_caps.assign( thread_caps, thread_caps + slot_count );
+                matched = true;
+                // 优先级更低的线程全部丢弃
+                break;
+            }
+            if ( i < text.size() && classes_[inst.x].Contains( text[i] ) ) {
+                std::copy( thread_caps, thread_caps + slot_count, caps.begin() );
+                add_thread( nlist, clist.pcs[t] + 1, i + 1 );
+            }
+        }
+        std::swap( clist, nlist );
+        if ( i >= text.size() ) {
+            break;
+        }
+    }
+
+    if ( !matched ) {
+        return StreamResult::kNoMatch;
+    }
+    groups.assign( group_count_, Span{} );
+    for ( size_t g = 0; g < group_count_; ++g ) {
+        if ( matched_caps[g * 2] != std::string_view::npos && matched_caps[g * 2 + 1] != std::string_view::npos ) {
+            groups[g] = Span{ matched_caps[g * 2], matched_caps[g * 2 + 1] };
+        }
+    }
+    return StreamResult::kMatch;
+}
+
+}  // namespace utils
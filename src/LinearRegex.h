@@ -0,0 +1,143 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "StringUtil.h"
+
+namespace utils {
+
+/**
+ * @brief 线性时间正则引擎（Thompson NFA + 惰性DFA）
+ *
+ * 与 std::regex 的回溯实现不同，单次查找的耗时与剩余输入长度成线性关系（O(n·m)，m为程序规模），
+ * 不会因为病态模式出现指数级耗时或栈溢出。
+ *
+ * 遍历所有匹配（StringUtil::ExtractAll 等）时，每次查找从上一个匹配之后重新开始，
+ * 并且要扫描到优先级更高的分支全部失败才能确定结果，因此最坏为 O(n²·m)。
+ * 例如 `\\w+@|\\w` 作用于一长串单词字符时，每次只匹配一个字符，却都要扫描到文本末尾。
+ * 处理不可信输入时，应避免高优先级分支能延伸很远、低优先级分支却很短的模式。
+ *
+ * 查找分两步：先用惰性构造的DFA扫描，判断剩余文本中是否存在匹配（无匹配时只需一次DFA扫描）；
+ * 存在匹配时再用带优先级的 Pike VM 求出最左优先匹配及各捕获组。
+ *
+ * 支持的语法（ECMAScript 常用子集）：
+ *   - 字面量、`.`（不匹配 \\n 和 \\r）、字符类 `[a-z]` `[^...]`
+ *   - 转义：`\\d \\D \\w \\W \\s \\S \\n \\r \\t \\f \\v \\0 \\xHH` 及标点转义
+ *   - 断言：`^` `$`（整个文本的首尾）、`\\b` `\\B`
+ *   - 分组：`(...)` 捕获、`(?:...)` 非捕获，`|` 选择
+ *   - 量词：`*` `+` `?` `{n}` `{n,}` `{n,m}` 及其惰性形式（后缀 `?`）
+ * 不支持反向引用和环视，编译时报错。
+ *
+ * 与 ECMAScript 的语义差异：ECMAScript 规定量词达到最小次数后，若某次迭代匹配了空串，则该迭代失败并回溯，
+ * 转而尝试组内能匹配非空的其他路径；本引擎直接接受空迭代，不做这种回溯。
+ * 因此被量词修饰且可匹配空串的分组（如 `(a*)*`、`(?:b*?)?`、`(.*?){1,2}`）不仅组内捕获可能不同，
+ * 整个匹配（第0组）的范围也可能不同：
+ *   - `\\d+?(?:b*?)?` 作用于 "c1bc"：本引擎匹配 "1"，ECMAScript 为 "1b"
+ *   - `(.*?){1,2}` 作用于 "__bc"：本引擎匹配空串，ECMAScript 为 "_"
+ *   - `(\\s?[^a]*?)+` 作用于 "b\\n _"：本引擎匹配 [0,3)，ECMAScript 为 [0,4)
+ * 另外这类分组重复时，组内捕获取最后一次非空迭代的值。不含这类分组的模式与 ECMAScript 一致。
+ * std::regex 在这类模式上也不完全符合 ECMAScript，两种引擎的 Extract* 结果可能不同。
+ *
+ * @note 编译结果不可变，可在多个线程中同时使用；并发查找时各线程从池中取用各自的DFA缓存
+ */
+class LinearRegex {
+public:
+    /// 捕获组在文本中的范围，未参与匹配的组 begin == end == npos
+    struct Span {
+        size_t begin = std::string_view::npos;
+        size_t end   = std::string_view::npos;
+
+        [[nodiscard]] bool Matched() const noexcept { return begin != std::string_view::npos; }
+    };
+
+    /**
+     * @brief 编译正则表达式
+     * @param pattern 正则表达式
+     * @param error_msg [out] 可选，编译失败时接收错误描述
+     * @return 编译结果；失败时返回 nullptr
+     */
+    [[nodiscard]] static std::unique_ptr<LinearRegex> Compile( std::string_view pattern,
+                                                               std::string     *error_msg = nullptr );
+
+    ~LinearRegex();
+
+    /// 捕获组数量（包括代表整个匹配的第0组）
+    [[nodiscard]] size_t GroupCount() const noexcept { return group_count_; }
+
+    /**
+     * @brief 从pos开始查找最左优先匹配
+     *
+     * 耗时与 text.size() - pos 成线性关系；确定匹配前可能需要扫描到匹配结束位置之后很远。
+     *
+     * @param text 完整文本（断言会参考pos之前的字符）
+     * @param pos 起始查找位置
+     * @param groups [out] 匹配成功时写入各捕获组范围，大小为 GroupCount()
+     * @param not_empty 为 true 时不接受从pos开始的空匹配；在空匹配之后以此重试，与 std::regex_iterator 一致
+     * @return 是否找到匹配
+     */
+    bool Search( std::string_view text, size_t pos, std::vector<Span> &groups, bool not_empty = false ) const;
+
+    /// 流式查找的结果
+    enum class StreamResult {
+        kNoMatch,   ///< 不存在匹配（只在输入已结束时出现）
+        kMatch,     ///< 找到匹配，且后续数据不会改变该结果
+        kNeedMore,  ///< 结果依赖后续数据
+    };
+
+    /**
+     * @brief 在流式输入的一段缓冲上查找
+     *
+     * 与 Search 语义相同，但 text 之后可能还有数据：贪婪量词可能继续延伸、`$` 和 `\b` 需要参考下一字节，
+     * 这类结果不会立即返回，而是报告 kNeedMore 并给出仍需保留的起始位置，调用方补充数据后再查找。
+     *
+     * @param text 当前缓冲
+     * @param pos 起始查找位置
+     * @param prev_byte text[0] 之前的字节（0~255），-1 表示 text 从输入开头开始
+     * @param complete text 之后是否已无数据；为 true 时不会返回 kNeedMore
+     * @param groups [out] 返回 kMatch 时写入各捕获组范围
+     * @param keep_from [out] 返回 kNeedMore 时，之后的匹配不会早于该位置开始，text[keep_from:] 需保留
+     * @param not_empty 为 true 时不接受从pos开始的空匹配，同 Search
+     * @return 查找结果
+     */
+    StreamResult SearchStream( std::string_view text, size_t pos, int prev_byte, bool complete,
+                               std::vector<Span> &groups, size_t &keep_from, bool not_empty = false ) const;
+
+private:
+    class Compiler;
+    class Dfa;
+    struct Inst;
+
+    LinearRegex();
+
+    /// 计算 first_bytes_ 和 use_first_bytes_
+    void ComputeFirstBytes();
+    /// 一次查找的输入及其上下文
+    struct Input {
+        std::string_view text;
+        int              prev_byte;  ///< text[0] 之前的字节，-1 表示输入开头
+        bool             complete;   ///< text 之后是否已无数据
+    };
+
+    /**
+     * @brief 用DFA扫描 text[pos:]
+     * @param idle [out] 未完成扫描时，存活的候选匹配都不早于该位置开始
+     * @return 1 存在匹配；0 不存在（输入未结束时表示扫描到末尾仍未确定）；-1 DFA状态过多，需交由NFA判断
+     */
+    int          ScanDfa( const Input &input, size_t pos, size_t &idle ) const;
+    StreamResult RunNfa( const Input &input, size_t pos, std::vector<Span> &groups, size_t &keep_from,
+                         bool not_empty ) const;
+
+    std::vector<Inst>    program_;
+    std::vector<CharSet> classes_;
+    CharSet              first_bytes_;               ///< 匹配可能的首字节
+    bool                 use_first_bytes_ = false;  ///< 模式不能匹配空串且不以断言开头时，可按首字节跳过起点
+    size_t               group_count_     = 1;
+
+    mutable std::mutex                        dfa_mutex_;
+    mutable std::vector<std::unique_ptr<Dfa>> dfa_pool_;  ///< 空闲的DFA缓存，查找时取出、用完归还
+};
+
+}  // namespace utils
@@ -0,0 +1,180 @@
+#include "RegexStream.h"
+
+#include "Macros.h"
+
+#if PLATFORM_OS_LINUX
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace utils {
+
+RegexStreamExtractor::RegexStreamExtractor( const CompiledRegex &regex, Callback on_match, size_t group_index,
+                                            size_t max_carry )
+    : regex_( regex ), on_match_( std::move( on_match ) ), group_index_( group_index ), max_carry_( max_carry ) {
+    if ( !regex_.Valid() ) {
+        return;
+    }
+    linear_ = regex_.Linear();
+    if ( !linear_ ) {
+        own_    = LinearRegex::Compile( regex_.Pattern() );
+        linear_ = own_.get();
+    }
+    if ( linear_ && group_index_ >= linear_->GroupCount() ) {
+        linear_ = nullptr;
+    }
+}
+
+bool RegexStreamExtractor::Feed( std::string_view chunk ) {
+    if ( !linear_ || stopped_ ) {
+        return false;
+    }
+    consumed_ += chunk.size();
+    // 没有未决数据时直接在调用方的块上查找
+    if ( carry_.empty() ) {
+        return Process( chunk, consumed_ - chunk.size(), false );
+    }
+    carry_.append( chunk );
+    return Process( carry_, carry_offset_, false );
+}
+
+bool RegexStreamExtractor::Finish( std::string_view last_chunk ) {
+    if ( !linear_ || stopped_ ) {
+        return false;
+    }
+    consumed_ += last_chunk.size();
+    if ( carry_.empty() ) {
+        return Process( last_chunk, consumed_ - last_chunk.size(), true );
+    }
+    carry_.append( last_chunk );
+    return Process( carry_, carry_offset_, true );
+}
+
+bool RegexStreamExtractor::Process( std::string_view buffer, uint64_t base, bool complete ) {
+    size_t pos       = next_pos_;
+    bool   not_empty = not_empty_;
+    size_t keep_from = buffer.size();
+    while ( true ) {
+        const auto result =
+            linear_->SearchStream( buffer, pos, prev_byte_, complete, groups_, keep_from, not_empty );
+        if ( result == LinearRegex::StreamResult::kNoMatch ) {
+            keep_from = buffer.size();
+            break;
+        }
+        if ( result == LinearRegex::StreamResult::kNeedMore ) {
+            break;
+        }
+
+        const LinearRegex::Span &span = groups_[group_index_];
+        if ( span.Matched() && !on_match_( buffer.substr( span.begin, span.end - span.begin ), base + span.begin ) ) {
+            stopped_ = true;
+            carry_.clear();
+            return false;
+        }
+        // 空匹配之后先在原位置重试非空匹配，与 ExtractAll 一致
+        pos       = groups_[0].end;
+        not_empty = groups_[0].end == groups_[0].begin;
+    }
+
+    next_pos_  = pos > keep_from ? pos - keep_from : 0;
+    not_empty_ = not_empty && keep_from <= pos;
+    if ( keep_from > 0 ) {
+        prev_byte_ = static_cast<unsigned char>( buffer[keep_from - 1] );
+    }
+    carry_offset_ = base + keep_from;
+    if ( complete || keep_from >= buffer.size() ) {
+        carry_.clear();
+        return true;
+    }
+
+    // buffer 可能就是 carry_ 本身
+    if ( buffer.data() == carry_.data() ) {
+        carry_.erase( 0, keep_from );
+    }
+    else {
+        carry_.assign( buffer.substr( keep_from ) );
+    }
+    // 未决数据过长，放弃其中的候选匹配
+    if ( carry_.size() > max_carry_ ) {
+        prev_byte_    = static_cast<unsigned char>( carry_.back() );
+        carry_offset_ += carry_.size();
+        next_pos_     = 0;
+        not_empty_    = false;
+        carry_.clear();
+    }
+    return true;
+}
+
+bool RegexStreamExtractor::ExtractFromFd( int fd, const CompiledRegex &regex, const Callback &on_match,
+                                          size_t group_index, size_t chunk_size ) {
+#if PLATFORM_OS_LINUX
+    RegexStreamExtractor extractor( regex, on_match, group_index );
+    if ( !extractor.Valid() || chunk_size == 0 ) {
+        return false;
+    }
+
+    std::vector<char> buffer( chunk_size );
+    while ( true ) {
+        const ssize_t n = ::read( fd, buffer.data(), buffer.size() );
+        if ( n < 0 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            return false;
+        }
+        if ( n == 0 ) {
+            return extractor.Finish();
+        }
+        if ( !extractor.Feed( std::string_view( buffer.data(), static_cast<size_t>( n ) ) ) ) {
+            return false;
+        }
+    }
+#else
+    (void)fd, (void)regex, (void)on_match, (void)group_index, (void)chunk_size;
+    return false;
+#endif
+}
+
+bool RegexStreamExtractor::ExtractFromFile( const std::string &path, const CompiledRegex &regex,
+                                            const Callback &on_match, size_t group_index ) {
+#if PLATFORM_OS_LINUX
+    RegexStreamExtractor extractor( regex, on_match, group_index );
+    if ( !extractor.Valid() ) {
+        return false;
+    }
+
+    const int fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if ( fd < 0 ) {
+        return false;
+    }
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0 ) {
+        ::close( fd );
+        return false;
+    }
+    const auto size = static_cast<size_t>( st.st_size );
+    // 空文件无法映射，也可能匹配空串
+    if ( size == 0 ) {
+        ::close( fd );
+        return extractor.Finish();
+    }
+
+    void *data = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+    if ( data == MAP_FAILED ) {
+        return false;
+    }
+    ::madvise( data, size, MADV_SEQUENTIAL );
+    const bool ok = extractor.Finish( std::string_view( static_cast<const char *>( data ), size ) );
+    ::munmap( data, size );
+    return ok;
+#else
+    (void)path, (void)regex, (void)on_match, (void)group_index;
+    return false;
+#endif
+}
+
+}  // namespace utils
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "LinearRegex.h"
+#include "StringUtil.h"
+
+namespace utils {
+
+/**
+ * @brief 流式正则提取器，逐块消费输入并以 string_view 回调匹配结果
+ *
+ * 适用于无法一次性载入内存的大文件（如多GB的日志归档）。匹配使用线性时间引擎（见 LinearRegex），
+ * 以 RegexEngine::kStd 编译的正则会按相同模式重新编译为线性引擎，不支持的语法视为无效。
+ *
+ * 匹配完全位于当前块内时，回调参数直接引用调用方传入的块，不做任何拷贝；
+ * 只有跨越块边界（或在块末尾尚不能确定）的匹配，才会把未决部分复制到内部的进位缓冲区，与下一块拼接后继续查找。
+ * 匹配结果及顺序与对完整输入调用 StringUtil::ExtractAll/ExtractAllGroups 一致。
+ *
+ * @note 回调中的 string_view 只在回调期间有效
+ * @note 进位缓冲区超过 max_carry 时会被丢弃，长度超过该值的跨块匹配可能被遗漏
+ * @note 与 ExtractAll 相同，遍历匹配最坏为平方复杂度（见 LinearRegex）
+ *
+ * @code{.cpp}
+ *   auto re = CompiledRegex::Compile( R"(ERROR (\w+))", nullptr, RegexEngine::kLinear );
+ *   RegexStreamExtractor extractor( re, []( std::string_view match, uint64_t offset ) {
+ *       std::cout << offset << ": " << match << "\n";
+ *       return true;  // 返回 false 可提前结束
+ *   } );
+ *   while ( ReadChunk( buffer ) ) {
+ *       extractor.Feed( buffer );
+ *   }
+ *   extractor.Finish();
+ * @endcode
+ */
+class RegexStreamExtractor {
+public:
+    /**
+     * @brief 匹配回调
+     * @param match 匹配内容（或指定的捕获组），未参与匹配的捕获组不回调
+     * @param offset match 在整个输入流中的偏移
+     * @return 返回 false 时停止提取
+     */
+    using Callback = std::function<bool( std::string_view match, uint64_t offset )>;
+
+    /// 进位缓冲区默认上限
+    static constexpr size_t kDefaultMaxCarry = 1 << 20;
+
+    /**
+     * @param regex 预编译正则
+     * @param on_match 匹配回调
+     * @param group_index 回调的捕获组，0 表示整个匹配
+     * @param max_carry 进位缓冲区上限
+     */
+    RegexStreamExtractor( const CompiledRegex &regex, Callback on_match, size_t group_index = 0,
+                          size_t max_carry = kDefaultMaxCarry );
+
+    /// 正则是否可用于流式提取（无效正则、线性引擎不支持的语法、捕获组越界时返回 false）
+    [[nodiscard]] bool Valid() const noexcept { return linear_ != nullptr; }
+    /// 回调是否已要求停止
+    [[nodiscard]] bool Stopped() const noexcept { return stopped_; }
+    /// 已消费的字节数
+    [[nodiscard]] uint64_t Consumed() const noexcept { return consumed_; }
+
+    /**
+     * @brief 输入一块数据
+     * @param chunk 数据块，只需在本次调用期间有效
+     * @return 提取器无效或回调要求停止时返回 false
+     */
+    bool Feed( std::string_view chunk );
+    /**
+     * @brief 标记输入结束，输出所有未决匹配；之后不应再调用 Feed
+     * @param last_chunk 可选的最后一块数据，没有未决数据时直接在其上查找，不做拷贝
+     * @return 提取器无效或回调要求停止时返回 false
+     */
+    bool Finish( std::string_view last_chunk = {} );
+
+    /**
+     * @brief 从文件描述符读取直到EOF并提取
+     * @param fd 可读的文件描述符（不会关闭）
+     * @param regex 预编译正则
+     * @param on_match 匹配回调
+     * @param group_index 回调的捕获组
+     * @param chunk_size 每次读取的字节数
+     * @return 读取出错、正则无效或回调要求停止时返回 false
+     */
+    static bool ExtractFromFd( int fd, const CompiledRegex &regex, const Callback &on_match, size_t group_index = 0,
+                               size_t chunk_size = 1 << 16 );
+    /**
+     * @brief 以内存映射方式提取整个文件，所有匹配都直接引用映射内存
+     * @param path 文件路径
+     * @param regex 预编译正则
+     * @param on_match 匹配回调
+     * @param group_index 回调的捕获组
+     * @return 打开/映射失败、正则无效或回调要求停止时返回 false
+     */
+    static bool ExtractFromFile( const std::string &path, const CompiledRegex &regex, const Callback &on_match,
+                                 size_t group_index = 0 );
+
+private:
+    /// 在 buffer 上查找并回调，buffer[0] 位于流偏移 base；结束后保留未决部分
+    bool Process( std::string_view buffer, uint64_t base, bool complete );
+
+    CompiledRegex                  regex_;  ///< 保持编译结果存活
+    std::unique_ptr<LinearRegex>   own_;    ///< regex_ 不是线性引擎时重新编译的结果
+    const LinearRegex             *linear_ = nullptr;
+    Callback                       on_match_;
+    size_t                         group_index_;
+    size_t                         max_carry_;
+    std::string                    carry_;             ///< 未决数据
+    uint64_t                       carry_offset_ = 0;  ///< carry_[0] 在流中的偏移
+    uint64_t                       consumed_     = 0;
+    int                            prev_byte_    = -1;     ///< 当前缓冲之前的字节，-1 表示流开头
+    size_t                         next_pos_     = 0;      ///< 下一次查找在当前缓冲中的起点
+    bool                           not_empty_    = false;  ///< 下一次查找是否为空匹配之后的重试
+    bool                           stopped_      = false;
+    std::vector<LinearRegex::Span> groups_;
+};
+
+}  // namespace utils
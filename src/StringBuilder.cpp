@@ -0,0 +1,68 @@
+#include "StringBuilder.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace utils {
+
+void StringBuilder::Reserve( size_t capacity ) {
+    if ( on_heap_ ) {
+        heap_.reserve( capacity );
+    }
+    else if ( capacity > kInlineCapacity ) {
+        MoveToHeap( capacity );
+    }
+}
+
+void StringBuilder::Resize( size_t size ) {
+    if ( !on_heap_ ) {
+        if ( size <= kInlineCapacity ) {
+            size_ = size;
+            return;
+        }
+        MoveToHeap( size );
+    }
+    heap_.resize( size );
+}
+
+StringBuilder &StringBuilder::AppendRepeated( std::string_view str, size_t times ) {
+    if ( str.empty() || times == 0 ) {
+        return *this;
+    }
+    if ( times > ( std::numeric_limits<size_t>::max() - Size() ) / str.size() ) {
+        throw std::length_error( "StringBuilder::AppendRepeated length overflow" );
+    }
+
+    const size_t total = str.size() * times;
+    const size_t start = Size();
+    Reserve( start + total );
+    Resize( start + total );
+    char *dst = Data() + start;
+    std::memcpy( dst, str.data(), str.size() );
+    // 每次复制已写入的全部内容，共 O(log times) 次 memcpy
+    size_t written = str.size();
+    while ( written <= total - written ) {
+        std::memcpy( dst + written, dst, written );
+        written *= 2;
+    }
+    std::memcpy( dst + written, dst, total - written );
+    return *this;
+}
+
+StringBuilder &StringBuilder::AppendSlow( std::string_view str ) {
+    if ( !on_heap_ ) {
+        // 按几何级数增长，避免反复追加时频繁重新分配
+        MoveToHeap( std::max( size_ + str.size(), kInlineCapacity * 2 ) );
+    }
+    heap_.append( str );
+    return *this;
+}
+
+void StringBuilder::MoveToHeap( size_t capacity ) {
+    heap_.reserve( capacity );
+    heap_.assign( inline_, size_ );
+    on_heap_ = true;
+}
+
+}  // namespace utils
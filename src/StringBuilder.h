@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace utils {
+
+/**
+ * @brief 带内联缓冲区的字符串构建器
+ *
+ * 内容不超过 kInlineCapacity 时完全保存在对象内部，不分配内存；超过后转存到堆上的 std::string，
+ * 并在 ToString 时直接移出，不再拷贝。已知总长度时先调用 Reserve，整个构建过程最多分配一次。
+ *
+ * @code{.cpp}
+ *   StringBuilder builder;
+ *   builder.Reserve( prefix.size() + name.size() + 1 );
+ *   builder.Append( prefix ).Append( '/' ).Append( name );
+ *   std::string path = std::move( builder ).ToString();
+ * @endcode
+ */
+class StringBuilder {
+public:
+    /// 内联缓冲区大小
+    static constexpr size_t kInlineCapacity = 256;
+
+    StringBuilder() noexcept {}
+
+    [[nodiscard]] size_t Size() const noexcept { return on_heap_ ? heap_.size() : size_; }
+    [[nodiscard]] bool   Empty() const noexcept { return Size() == 0; }
+    [[nodiscard]] size_t Capacity() const noexcept { return on_heap_ ? heap_.capacity() : kInlineCapacity; }
+    [[nodiscard]] char  *Data() noexcept { return on_heap_ ? heap_.data() : inline_; }
+    [[nodiscard]] const char *Data() const noexcept { return on_heap_ ? heap_.data() : inline_; }
+    [[nodiscard]] std::string_view View() const noexcept { return std::string_view( Data(), Size() ); }
+
+    /**
+     * @brief 确保容量至少为 capacity，超过内联容量时按该值精确分配
+     */
+    void Reserve( size_t capacity );
+    /**
+     * @brief 调整长度，新增部分的内容未指定，用于让外部函数（如 snprintf）直接写入 Data()
+     */
+    void Resize( size_t size );
+    /// 清空内容，保留已分配的容量
+    void Clear() noexcept {
+        size_ = 0;
+        heap_.clear();
+    }
+
+    StringBuilder &Append( std::string_view str ) {
+        if ( !on_heap_ && str.size() <= kInlineCapacity - size_ ) {
+            if ( !str.empty() ) {
+                std::memcpy( inline_ + size_, str.data(), str.size() );
+                size_ += str.size();
+            }
+            return *this;
+        }
+        return AppendSlow( str );
+    }
+    StringBuilder &Append( char c ) { return Append( std::string_view( &c, 1 ) ); }
+    /**
+     * @brief 追加 times 个 str，先一次扩容，再以倍增的 memcpy 填充
+     * @throw std::length_error 总长度溢出时抛出
+     */
+    StringBuilder &AppendRepeated( std::string_view str, size_t times );
+
+    /// 拷贝出结果
+    [[nodiscard]] std::string ToString() const & { return std::string( View() ); }
+    /// 移出结果，内容在堆上时不再分配内存
+    [[nodiscard]] std::string ToString() && {
+        if ( on_heap_ ) {
+            return std::move( heap_ );
+        }
+        return std::string( inline_, size_ );
+    }
+
+private:
+    StringBuilder &AppendSlow( std::string_view str );
+    /// 把内联内容转存到容量为 capacity 的堆缓冲区
+    void MoveToHeap( size_t capacity );
+
+    char        inline_[kInlineCapacity];
+    size_t      size_ = 0;
+    std::string heap_;
+    bool        on_heap_ = false;
+};
+
+}  // namespace utils
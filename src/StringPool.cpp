@@ -0,0 +1,140 @@
+#include "StringPool.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace utils {
+
+namespace {
+
+/// 分片取哈希高32位，与 unordered_map 按低位取桶的方式错开
+size_t ShardIndex( std::string_view str, size_t shard_count ) noexcept {
+    return static_cast<size_t>( StringUtil::Hash( str ) >> 32 ) % shard_count;
+}
+
+/// 编号所在的分段及段内偏移：第 0 段容纳 2^first_bits 个编号，之后第 n 段容纳 2^(first_bits+n-1) 个
+struct SegmentPos {
+    size_t segment;
+    size_t offset;
+};
+
+SegmentPos SegmentOf( uint32_t id, size_t first_bits ) noexcept {
+    const uint64_t bucket = static_cast<uint64_t>( id ) >> first_bits;
+    if ( bucket == 0 ) {
+        return { 0, id };
+    }
+    size_t segment = 0;
+    for ( uint64_t b = bucket; b != 0; b >>= 1 ) {
+        ++segment;
+    }
+    return { segment, id - ( size_t{ 1 } << ( first_bits + segment - 1 ) ) };
+}
+
+size_t SegmentSize( size_t segment, size_t first_bits ) noexcept {
+    return size_t{ 1 } << ( segment == 0 ? first_bits : first_bits + segment - 1 );
+}
+
+}  // namespace
+
+StringPool::StringPool( size_t chunk_size ) : chunk_size_( chunk_size == 0 ? kDefaultChunkSize : chunk_size ) {}
+
+StringPool::~StringPool() {
+    for ( auto &segment : segments_ ) {
+        delete[] segment.load( std::memory_order_relaxed );
+    }
+}
+
+StringPool::Interned StringPool::Intern( std::string_view str ) {
+    Shard &shard = shards_[ShardIndex( str, kShardCount )];
+    {
+        std::shared_lock<std::shared_mutex> lock( shard.mutex );
+        auto                                iter = shard.index.find( str );
+        if ( iter != shard.index.end() ) {
+            return { iter->first, iter->second };
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock( shard.mutex );
+    auto                                iter = shard.index.find( str );
+    if ( iter != shard.index.end() ) {
+        return { iter->first, iter->second };
+    }
+
+    uint32_t id = next_id_.load( std::memory_order_relaxed );
+    do {
+        if ( id >= kMaxId ) {
+            throw std::length_error( "StringPool id space exhausted" );
+        }
+    } while ( !next_id_.compare_exchange_weak( id, id + 1, std::memory_order_acq_rel ) );
+
+    // 先写入编号表再发布到索引，其他线程通过索引拿到编号时 Get 一定可见
+    const std::string_view stored = Store( shard, str );
+    SetEntry( id, stored );
+    shard.index.emplace( stored, id );
+    return { stored, id };
+}
+
+std::optional<uint32_t> StringPool::Find( std::string_view str ) const {
+    const Shard                        &shard = shards_[ShardIndex( str, kShardCount )];
+    std::shared_lock<std::shared_mutex> lock( shard.mutex );
+    auto                                iter = shard.index.find( str );
+    if ( iter == shard.index.end() ) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
+std::string_view StringPool::Get( uint32_t id ) const noexcept {
+    const auto pos = SegmentOf( id, kFirstSegmentBits );
+    return segments_[pos.segment].load( std::memory_order_acquire )[pos.offset];
+}
+
+size_t StringPool::BytesAllocated() const noexcept {
+    size_t total = 0;
+    for ( const auto &shard : shards_ ) {
+        std::shared_lock<std::shared_mutex> lock( shard.mutex );
+        total += shard.bytes;
+    }
+    return total;
+}
+
+std::string_view StringPool::Store( Shard &shard, std::string_view str ) {
+    if ( str.empty() ) {
+        return std::string_view( "", 0 );
+    }
+    // 较大的字符串单独分配，避免浪费当前块的剩余空间
+    if ( str.size() > chunk_size_ / 2 ) {
+        auto buffer = std::make_unique<char[]>( str.size() );
+        std::memcpy( buffer.get(), str.data(), str.size() );
+        shard.chunks.push_back( std::move( buffer ) );
+        shard.bytes += str.size();
+        return std::string_view( shard.chunks.back().get(), str.size() );
+    }
+    if ( str.size() > shard.remaining ) {
+        shard.chunks.push_back( std::make_unique<char[]>( chunk_size_ ) );
+        shard.cursor    = shard.chunks.back().get();
+        shard.remaining = chunk_size_;
+        shard.bytes += chunk_size_;
+    }
+    char *dest = shard.cursor;
+    std::memcpy( dest, str.data(), str.size() );
+    shard.cursor += str.size();
+    shard.remaining -= str.size();
+    return std::string_view( dest, str.size() );
+}
+
+void StringPool::SetEntry( uint32_t id, std::string_view str ) {
+    const auto        pos     = SegmentOf( id, kFirstSegmentBits );
+    std::string_view *segment = segments_[pos.segment].load( std::memory_order_acquire );
+    if ( segment == nullptr ) {
+        std::lock_guard<std::mutex> lock( segment_mutex_ );
+        segment = segments_[pos.segment].load( std::memory_order_relaxed );
+        if ( segment == nullptr ) {
+            segment = new std::string_view[SegmentSize( pos.segment, kFirstSegmentBits )];
+            segments_[pos.segment].store( segment, std::memory_order_release );
+        }
+    }
+    segment[pos.offset] = str;
+}
+
+}  // namespace utils
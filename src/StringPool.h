@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Macros.h"
+#include "StringUtil.h"
+
+namespace utils {
+
+/**
+ * @brief 线程安全的字符串驻留池，为每个不同的字符串分配一份存储和一个32位编号
+ *
+ * 适用于取值集合较小但重复出现次数很多的字段（主机名、日志级别、模块名等）：
+ * 相同内容只保存一次，比较两个驻留字符串只需比较编号。
+ *   - 字符串内容拷贝到按块分配的内存区（arena）中，返回的 string_view 在池的生命周期内一直有效
+ *   - 查找表按哈希分为多个分片，各自持有读写锁；已存在字符串的查找只取共享锁，不同分片的插入互不阻塞
+ *   - 编号从 0 开始连续分配，Get 通过分段数组按编号取回内容，不需要加锁
+ *
+ * @code{.cpp}
+ *   StringPool pool;
+ *   for ( auto field : StringUtil::SplitRef( line, " " ) ) {
+ *       auto [host, id] = pool.Intern( field );
+ *       // host 指向池内存储，可在 pool 销毁前一直使用
+ *   }
+ *   std::string_view name = pool.Get( id );
+ * @endcode
+ */
+class StringPool {
+public:
+    /// 驻留结果
+    struct Interned {
+        std::string_view view;  ///< 池内存储的内容
+        uint32_t         id;    ///< 编号
+    };
+
+    /// 默认的内存块大小
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+    /// 编号上限（不含）
+    static constexpr uint32_t kMaxId = UINT32_MAX;
+
+    /**
+     * @param chunk_size 每个内存块的大小，超过其一半的字符串单独分配
+     */
+    explicit StringPool( size_t chunk_size = kDefaultChunkSize );
+    ~StringPool();
+    DISABLE_COPY_MOVE( StringPool )
+
+    /**
+     * @brief 驻留字符串，已存在时返回原有的存储和编号
+     * @param str 字符串
+     * @return Interned
+     * @throw std::length_error 编号用尽时抛出
+     */
+    Interned Intern( std::string_view str );
+    /**
+     * @brief 查找字符串，不存在时不插入
+     * @param str 字符串
+     * @return 存在时返回编号
+     */
+    [[nodiscard]] std::optional<uint32_t> Find( std::string_view str ) const;
+    /**
+     * @brief 按编号取回内容
+     * @param id Intern 返回的编号；传入未分配的编号是未定义行为
+     * @return std::string_view
+     */
+    [[nodiscard]] std::string_view Get( uint32_t id ) const noexcept;
+
+    /// 不同字符串的数量
+    [[nodiscard]] size_t Size() const noexcept { return next_id_.load( std::memory_order_acquire ); }
+    [[nodiscard]] bool   Empty() const noexcept { return Size() == 0; }
+    /// 为字符串内容分配的总字节数
+    [[nodiscard]] size_t BytesAllocated() const noexcept;
+
+private:
+    static constexpr size_t kShardCount       = 16;
+    static constexpr size_t kFirstSegmentBits = 10;
+    static constexpr size_t kSegmentCount     = 32 - kFirstSegmentBits + 1;
+
+    struct Shard {
+        mutable std::shared_mutex                                              mutex;
+        std::unordered_map<std::string_view, uint32_t, StringHash, StringEqual> index;
+        std::vector<std::unique_ptr<char[]>>                                   chunks;
+        char                                                                  *cursor    = nullptr;
+        size_t                                                                 remaining = 0;
+        size_t                                                                 bytes     = 0;
+    };
+
+    /// 在分片的内存区中保存一份 str
+    std::string_view Store( Shard &shard, std::string_view str );
+    /// 写入编号对应的内容，按需分配分段
+    void SetEntry( uint32_t id, std::string_view str );
+
+    size_t                          chunk_size_;
+    Shard                           shards_[kShardCount];
+    std::atomic<uint32_t>           next_id_{ 0 };
+    std::mutex                      segment_mutex_;
+    std::atomic<std::string_view *> segments_[kSegmentCount] = {};  ///< 按编号索引的分段数组
+};
+
+}  // namespace utils
@@ -1,10 +1,1160 @@
 #include "StringUtil.h"
+#include "LinearRegex.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <mutex>
 #include <random>
 #include <regex>
+#include <unordered_map>
+
+#if defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+    #define UTILS_STRING_SIMD_X86 1
+    #include <immintrin.h>
+    #define UTILS_TARGET_AVX2  __attribute__( ( target( "avx2" ) ) )
+    #define UTILS_TARGET_SSSE3 __attribute__( ( target( "ssse3" ) ) )
+#endif
 
 namespace utils {
 
+namespace {
+
+/// 运行时检测CPU是否支持AVX2，结果只计算一次
+[[maybe_unused]] bool CpuHasAvx2() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    static const bool has_avx2 = __builtin_cpu_supports( "avx2" );
+    return has_avx2;
+#else
+    return false;
+#endif
+}
+
+/// 运行时检测CPU是否支持SSSE3（PSHUFB）
+[[maybe_unused]] bool CpuHasSsse3() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    static const bool has_ssse3 = __builtin_cpu_supports( "ssse3" );
+    return has_ssse3;
+#else
+    return false;
+#endif
+}
+
+/**
+ * 字符集分块扫描内核：用半字节查找表每次分类一个块，
+ * 返回第一个命中（negate时为第一个未命中）字节的位置；
+ * 若整块部分均无命中，返回尚未扫描的尾部起点，由调用方逐字节处理剩余部分。
+ */
+using CharSetScanFunc = size_t ( * )( const char *, size_t, const uint8_t *, const uint8_t *, bool );
+
+#ifdef UTILS_STRING_SIMD_X86
+UTILS_TARGET_SSSE3 size_t CharSetScanSsse3( const char *data, size_t size, const uint8_t *lo_nibble,
+                                            const uint8_t *hi_nibble, bool negate ) {
+    const __m128i lo_table = _mm_loadu_si128( reinterpret_cast<const __m128i *>( lo_nibble ) );
+    const __m128i hi_table = _mm_loadu_si128( reinterpret_cast<const __m128i *>( hi_nibble ) );
+    const __m128i low_mask = _mm_set1_epi8( 0x0F );
+    const __m128i zero     = _mm_setzero_si128();
+    size_t        i        = 0;
+    for ( ; i + 16 <= size; i += 16 ) {
+        const __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i *>( data + i ) );
+        const __m128i lo    = _mm_and_si128( block, low_mask );
+        const __m128i hi    = _mm_and_si128( _mm_srli_epi16( block, 4 ), low_mask );
+        const __m128i hit   = _mm_and_si128( _mm_shuffle_epi8( lo_table, lo ), _mm_shuffle_epi8( hi_table, hi ) );
+        // miss的位为1
+        auto mask = static_cast<uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( hit, zero ) ) );
+        if ( !negate ) {
+            mask = ~mask & 0xFFFFu;
+        }
+        if ( mask != 0 ) {
+            return i + static_cast<size_t>( __builtin_ctz( mask ) );
+        }
+    }
+    return i;
+}
+
+UTILS_TARGET_AVX2 size_t CharSetScanAvx2( const char *data, size_t size, const uint8_t *lo_nibble,
+                                          const uint8_t *hi_nibble, bool negate ) {
+    const __m256i lo_table =
+        _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast<const __m128i *>( lo_nibble ) ) );
+    const __m256i hi_table =
+        _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast<const __m128i *>( hi_nibble ) ) );
+    const __m256i low_mask = _mm256_set1_epi8( 0x0F );
+    const __m256i zero     = _mm256_setzero_si256();
+    size_t        i        = 0;
+    for ( ; i + 32 <= size; i += 32 ) {
+        const __m256i block = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+        const __m256i lo    = _mm256_and_si256( block, low_mask );
+        const __m256i hi    = _mm256_and_si256( _mm256_srli_epi16( block, 4 ), low_mask );
+        const __m256i hit =
+            _mm256_and_si256( _mm256_shuffle_epi8( lo_table, lo ), _mm256_shuffle_epi8( hi_table, hi ) );
+        auto mask = static_cast<uint32_t>( _mm256_movemask_epi8( _mm256_cmpeq_epi8( hit, zero ) ) );
+        if ( !negate ) {
+            mask = ~mask;
+        }
+        if ( mask != 0 ) {
+            return i + static_cast<size_t>( __builtin_ctz( mask ) );
+        }
+    }
+    return i;
+}
+#endif
+
+/// 根据CPU特性选择字符集扫描内核，不支持时返回nullptr
+CharSetScanFunc SelectCharSetScan() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasAvx2() ) {
+        return CharSetScanAvx2;
+    }
+    if ( CpuHasSsse3() ) {
+        return CharSetScanSsse3;
+    }
+#endif
+    return nullptr;
+}
+
+/// 十六进制字符值查找表，非十六进制字符为-1
+constexpr std::array<int8_t, 256> MakeHexDigitTable() noexcept {
+    std::array<int8_t, 256> table{};
+    for ( int c = 0; c < 256; ++c ) {
+        table[c] = -1;
+    }
+    for ( int c = '0'; c <= '9'; ++c ) {
+        table[c] = static_cast<int8_t>( c - '0' );
+    }
+    for ( int c = 0; c < 6; ++c ) {
+        table['A' + c] = static_cast<int8_t>( c + 10 );
+        table['a' + c] = static_cast<int8_t>( c + 10 );
+    }
+    return table;
+}
+
+constexpr std::array<int8_t, 256> kHexDigitTable = MakeHexDigitTable();
+
+/// 十六进制字符的值，非十六进制字符返回-1
+inline int HexDigitValue( char c ) noexcept {
+    return kHexDigitTable[static_cast<unsigned char>( c )];
+}
+
+/**
+ * 十六进制编码内核：每个字节写出两个字符（digits 为16个数字字符），
+ * 返回已编码的字节数，剩余尾部由调用方逐字节处理。
+ */
+using HexEncodeFunc = size_t ( * )( const char *, size_t, char *, const char * );
+
+/**
+ * 十六进制解码内核：每两个字符解码为一个字节，
+ * 返回已解码的字节数；遇到非法字符所在的块即停止，由调用方定位错误。
+ */
+using HexDecodeFunc = size_t ( * )( const char *, size_t, char * );
+
+#ifdef UTILS_STRING_SIMD_X86
+UTILS_TARGET_SSSE3 size_t HexEncodeSsse3( const char *data, size_t size, char *dst, const char *digits ) {
+    const __m128i table    = _mm_loadu_si128( reinterpret_cast<const __m128i *>( digits ) );
+    const __m128i low_mask = _mm_set1_epi8( 0x0F );
+    size_t        i        = 0;
+    for ( ; i + 16 <= size; i += 16 ) {
+        const __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i *>( data + i ) );
+        const __m128i high  = _mm_shuffle_epi8( table, _mm_and_si128( _mm_srli_epi16( block, 4 ), low_mask ) );
+        const __m128i low   = _mm_shuffle_epi8( table, _mm_and_si128( block, low_mask ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( dst + 2 * i ), _mm_unpacklo_epi8( high, low ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( dst + 2 * i + 16 ), _mm_unpackhi_epi8( high, low ) );
+    }
+    return i;
+}
+
+UTILS_TARGET_AVX2 size_t HexEncodeAvx2( const char *data, size_t size, char *dst, const char *digits ) {
+    const __m256i table =
+        _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast<const __m128i *>( digits ) ) );
+    const __m256i low_mask = _mm256_set1_epi8( 0x0F );
+    size_t        i        = 0;
+    for ( ; i + 32 <= size; i += 32 ) {
+        const __m256i block = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+        const __m256i high =
+            _mm256_shuffle_epi8( table, _mm256_and_si256( _mm256_srli_epi16( block, 4 ), low_mask ) );
+        const __m256i low = _mm256_shuffle_epi8( table, _mm256_and_si256( block, low_mask ) );
+        // unpack 按128位通道交错，需要再把两个通道拼回原始顺序
+        const __m256i first  = _mm256_unpacklo_epi8( high, low );
+        const __m256i second = _mm256_unpackhi_epi8( high, low );
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( dst + 2 * i ),
+                             _mm256_permute2x128_si256( first, second, 0x20 ) );
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( dst + 2 * i + 32 ),
+                             _mm256_permute2x128_si256( first, second, 0x31 ) );
+    }
+    return i;
+}
+
+/// 把16个十六进制字符转换为数值，valid 中非法字符对应位为0
+UTILS_TARGET_SSSE3 inline __m128i HexDigitsToValues( __m128i chars, int &valid ) {
+    const __m128i digit  = _mm_sub_epi8( chars, _mm_set1_epi8( '0' ) );
+    const __m128i letter = _mm_sub_epi8( _mm_or_si128( chars, _mm_set1_epi8( 0x20 ) ), _mm_set1_epi8( 'a' ) );
+    // 无符号比较：x <= n 等价于 min(x, n) == x
+    const __m128i is_digit  = _mm_cmpeq_epi8( _mm_min_epu8( digit, _mm_set1_epi8( 9 ) ), digit );
+    const __m128i is_letter = _mm_cmpeq_epi8( _mm_min_epu8( letter, _mm_set1_epi8( 5 ) ), letter );
+    valid                   = _mm_movemask_epi8( _mm_or_si128( is_digit, is_letter ) );
+    return _mm_or_si128( _mm_and_si128( is_digit, digit ),
+                         _mm_and_si128( is_letter, _mm_add_epi8( letter, _mm_set1_epi8( 10 ) ) ) );
+}
+
+UTILS_TARGET_SSSE3 size_t HexDecodeSsse3( const char *hex, size_t count, char *dst ) {
+    // 相邻两个半字节合并为 high * 16 + low
+    const __m128i weights = _mm_set1_epi16( 0x0110 );
+    size_t        i       = 0;
+    for ( ; i + 16 <= count; i += 16 ) {
+        int           valid_first  = 0;
+        int           valid_second = 0;
+        const __m128i first        = HexDigitsToValues(
+            _mm_loadu_si128( reinterpret_cast<const __m128i *>( hex + 2 * i ) ), valid_first );
+        const __m128i second = HexDigitsToValues(
+            _mm_loadu_si128( reinterpret_cast<const __m128i *>( hex + 2 * i + 16 ) ), valid_second );
+        if ( ( valid_first & valid_second ) != 0xFFFF ) {
+            break;
+        }
+        const __m128i bytes =
+            _mm_packus_epi16( _mm_maddubs_epi16( first, weights ), _mm_maddubs_epi16( second, weights ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( dst + i ), bytes );
+    }
+    return i;
+}
+#endif
+
+/// 根据CPU特性选择十六进制编码内核，不支持时返回nullptr
+HexEncodeFunc SelectHexEncode() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasAvx2() ) {
+        return HexEncodeAvx2;
+    }
+    if ( CpuHasSsse3() ) {
+        return HexEncodeSsse3;
+    }
+#endif
+    return nullptr;
+}
+
+/// 根据CPU特性选择十六进制解码内核，不支持时返回nullptr
+HexDecodeFunc SelectHexDecode() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasSsse3() ) {
+        return HexDecodeSsse3;
+    }
+#endif
+    return nullptr;
+}
+
+/// Base64 的 62/63 两个字符
+struct Base64Extra {
+    char c62;
+    char c63;
+};
+
+constexpr Base64Extra Base64ExtraChars( Base64Alphabet alphabet ) noexcept {
+    return alphabet == Base64Alphabet::kUrlSafe ? Base64Extra{ '-', '_' } : Base64Extra{ '+', '/' };
+}
+
+/// Base64 解码表中的特殊值
+constexpr int8_t kBase64Invalid = -1;
+constexpr int8_t kBase64Space   = -2;
+
+/// Base64 解码查找表；lenient 时同时接受两种字母表的 62/63 字符，并把空白标记为 kBase64Space
+constexpr std::array<int8_t, 256> MakeBase64DecodeTable( Base64Alphabet alphabet, bool lenient ) noexcept {
+    std::array<int8_t, 256> table{};
+    for ( int c = 0; c < 256; ++c ) {
+        table[c] = kBase64Invalid;
+    }
+    for ( int c = 0; c < 26; ++c ) {
+        table['A' + c] = static_cast<int8_t>( c );
+        table['a' + c] = static_cast<int8_t>( c + 26 );
+    }
+    for ( int c = 0; c < 10; ++c ) {
+        table['0' + c] = static_cast<int8_t>( c + 52 );
+    }
+    const Base64Extra extra = Base64ExtraChars( alphabet );
+    table[static_cast<unsigned char>( extra.c62 )] = 62;
+    table[static_cast<unsigned char>( extra.c63 )] = 63;
+    if ( lenient ) {
+        table['+'] = table['-'] = 62;
+        table['/'] = table['_'] = 63;
+        for ( const char c : { ' ', '\t', '\n', '\r', '\v', '\f' } ) {
+            table[static_cast<unsigned char>( c )] = kBase64Space;
+        }
+    }
+    return table;
+}
+
+/// Base64 编码内核：每3字节写出4个字符，返回已编码的字节数（3的倍数）
+using Base64EncodeFunc = size_t ( * )( const char *, size_t, char *, Base64Extra );
+
+/// Base64 解码内核：每4个字符写出3字节，返回已解码的字符数（4的倍数）；可能在输出末尾多写最多8个字节
+using Base64DecodeFunc = size_t ( * )( const char *, size_t, char *, Base64Extra );
+
+#ifdef UTILS_STRING_SIMD_X86
+UTILS_TARGET_AVX2 size_t Base64EncodeAvx2( const char *data, size_t size, char *dst, Base64Extra extra ) {
+    // 每个通道处理12字节：重排为 [b1 b0 b2 b1]，再用乘法把4个6位索引移到各自的字节
+    const __m256i shuffle = _mm256_setr_epi8( 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5,
+                                              4, 7, 6, 8, 7, 10, 9, 11, 10 );
+    // 索引区间到字符的偏移：A-Z、a-z、0-9、62、63
+    const __m256i offsets =
+        _mm256_setr_epi8( 'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                          '0' - 52, '0' - 52, '0' - 52, extra.c62 - 62, extra.c63 - 63, 0, 0, 'A', 'a' - 26, '0' - 52,
+                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                          extra.c62 - 62, extra.c63 - 63, 0, 0 );
+    size_t i   = 0;
+    char  *out = dst;
+    for ( ; i + 28 <= size; i += 24 ) {
+        const __m128i low  = _mm_loadu_si128( reinterpret_cast<const __m128i *>( data + i ) );
+        const __m128i high = _mm_loadu_si128( reinterpret_cast<const __m128i *>( data + i + 12 ) );
+        const __m256i in   = _mm256_shuffle_epi8( _mm256_inserti128_si256( _mm256_castsi128_si256( low ), high, 1 ),
+                                                  shuffle );
+        const __m256i ac   = _mm256_mulhi_epu16( _mm256_and_si256( in, _mm256_set1_epi32( 0x0FC0FC00 ) ),
+                                                 _mm256_set1_epi32( 0x04000040 ) );
+        const __m256i bd   = _mm256_mullo_epi16( _mm256_and_si256( in, _mm256_set1_epi32( 0x003F03F0 ) ),
+                                                 _mm256_set1_epi32( 0x01000010 ) );
+        const __m256i indices = _mm256_or_si256( ac, bd );
+
+        // 0-25 -> 0，26-51 -> 1，52-61 -> 2..11，62 -> 12，63 -> 13
+        __m256i reduced = _mm256_subs_epu8( indices, _mm256_set1_epi8( 51 ) );
+        reduced = _mm256_sub_epi8( reduced, _mm256_cmpgt_epi8( indices, _mm256_set1_epi8( 25 ) ) );
+        const __m256i chars = _mm256_add_epi8( indices, _mm256_shuffle_epi8( offsets, reduced ) );
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), chars );
+        out += 32;
+    }
+    return i;
+}
+
+UTILS_TARGET_AVX2 size_t Base64DecodeAvx2( const char *src, size_t size, char *dst, Base64Extra extra ) {
+    const __m256i c62     = _mm256_set1_epi8( extra.c62 );
+    const __m256i c63     = _mm256_set1_epi8( extra.c63 );
+    const __m256i shuffle = _mm256_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+                                              4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 );
+    // 至少保留48个字符，保证多写的8个字节仍在输出缓冲区内
+    size_t i   = 0;
+    char  *out = dst;
+    for ( ; i + 48 <= size; i += 32 ) {
+        const __m256i in = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( src + i ) );
+        // 无符号比较：x <= n 等价于 min(x, n) == x
+        const __m256i upper    = _mm256_sub_epi8( in, _mm256_set1_epi8( 'A' ) );
+        const __m256i lower    = _mm256_sub_epi8( in, _mm256_set1_epi8( 'a' ) );
+        const __m256i digit    = _mm256_sub_epi8( in, _mm256_set1_epi8( '0' ) );
+        const __m256i is_upper = _mm256_cmpeq_epi8( _mm256_min_epu8( upper, _mm256_set1_epi8( 25 ) ), upper );
+        const __m256i is_lower = _mm256_cmpeq_epi8( _mm256_min_epu8( lower, _mm256_set1_epi8( 25 ) ), lower );
+        const __m256i is_digit = _mm256_cmpeq_epi8( _mm256_min_epu8( digit, _mm256_set1_epi8( 9 ) ), digit );
+        const __m256i is_62    = _mm256_cmpeq_epi8( in, c62 );
+        const __m256i is_63    = _mm256_cmpeq_epi8( in, c63 );
+        const __m256i valid    = _mm256_or_si256( _mm256_or_si256( is_upper, is_lower ),
+                                                  _mm256_or_si256( is_digit, _mm256_or_si256( is_62, is_63 ) ) );
+        if ( _mm256_movemask_epi8( valid ) != -1 ) {
+            break;
+        }
+
+        const __m256i letters = _mm256_or_si256(
+            _mm256_and_si256( is_upper, upper ),
+            _mm256_and_si256( is_lower, _mm256_add_epi8( lower, _mm256_set1_epi8( 26 ) ) ) );
+        const __m256i others = _mm256_or_si256(
+            _mm256_and_si256( is_digit, _mm256_add_epi8( digit, _mm256_set1_epi8( 52 ) ) ),
+            _mm256_or_si256( _mm256_and_si256( is_62, _mm256_set1_epi8( 62 ) ),
+                             _mm256_and_si256( is_63, _mm256_set1_epi8( 63 ) ) ) );
+        const __m256i values = _mm256_or_si256( letters, others );
+
+        // 4个6位值合并为24位：先两两合并为12位，再合并为24位
+        const __m256i pairs  = _mm256_maddubs_epi16( values, _mm256_set1_epi32( 0x01400140 ) );
+        const __m256i words  = _mm256_madd_epi16( pairs, _mm256_set1_epi32( 0x00011000 ) );
+        const __m256i bytes  = _mm256_shuffle_epi8( words, shuffle );
+        const __m256i packed = _mm256_permutevar8x32_epi32( bytes, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 3, 7 ) );
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), packed );
+        out += 24;
+    }
+    return i;
+}
+#endif
+
+/// 根据CPU特性选择 Base64 编码内核，不支持时返回nullptr
+Base64EncodeFunc SelectBase64Encode() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasAvx2() ) {
+        return Base64EncodeAvx2;
+    }
+#endif
+    return nullptr;
+}
+
+/// 根据CPU特性选择 Base64 解码内核，不支持时返回nullptr
+Base64DecodeFunc SelectBase64Decode() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasAvx2() ) {
+        return Base64DecodeAvx2;
+    }
+#endif
+    return nullptr;
+}
+
+/// ASCII字母转小写，其余字节不变
+inline char AsciiToLower( char c ) noexcept {
+    return static_cast<unsigned char>( c - 'A' ) < 26 ? static_cast<char>( c + 32 ) : c;
+}
+
+/// ASCII字母转大写，其余字节不变
+inline char AsciiToUpper( char c ) noexcept {
+    return static_cast<unsigned char>( c - 'a' ) < 26 ? static_cast<char>( c - 32 ) : c;
+}
+
+/// 原地大小写转换内核：把 [first, first+25] 内的字节翻转 0x20 位，返回已处理的字节数
+using CaseConvertFunc = size_t ( * )( char *, size_t, char );
+
+/// 忽略大小写比较内核：返回第一个不同字节的位置，整块部分都相同时返回尚未比较的尾部起点
+using MismatchIgnoreCaseFunc = size_t ( * )( const char *, const char *, size_t );
+
+/**
+ * 忽略大小写查找内核：从 pos 开始用首尾字节过滤候选位置并逐个校验。
+ * 找到时返回 true 且 pos 为匹配位置；否则 pos 为尚未检查的第一个候选位置，由调用方处理剩余部分。
+ */
+using FindIgnoreCaseFunc = bool ( * )( std::string_view, std::string_view, size_t & );
+
+#ifdef UTILS_STRING_SIMD_X86
+/// 把32字节中的大写ASCII字母转为小写
+UTILS_TARGET_AVX2 inline __m256i FoldToLowerAvx2( __m256i block ) {
+    const __m256i offset   = _mm256_sub_epi8( block, _mm256_set1_epi8( 'A' ) );
+    const __m256i is_upper = _mm256_cmpeq_epi8( _mm256_min_epu8( offset, _mm256_set1_epi8( 25 ) ), offset );
+    return _mm256_or_si256( block, _mm256_and_si256( is_upper, _mm256_set1_epi8( 0x20 ) ) );
+}
+
+UTILS_TARGET_AVX2 size_t CaseConvertAvx2( char *data, size_t size, char first ) {
+    const __m256i base = _mm256_set1_epi8( first );
+    size_t        i    = 0;
+    for ( ; i + 32 <= size; i += 32 ) {
+        const __m256i block  = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+        const __m256i offset = _mm256_sub_epi8( block, base );
+        const __m256i hit    = _mm256_cmpeq_epi8( _mm256_min_epu8( offset, _mm256_set1_epi8( 25 ) ), offset );
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( data + i ),
+                             _mm256_xor_si256( block, _mm256_and_si256( hit, _mm256_set1_epi8( 0x20 ) ) ) );
+    }
+    return i;
+}
+
+UTILS_TARGET_AVX2 size_t MismatchIgnoreCaseAvx2( const char *str1, const char *str2, size_t size ) {
+    size_t i = 0;
+    for ( ; i + 32 <= size; i += 32 ) {
+        const __m256i block1 = FoldToLowerAvx2( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( str1 + i ) ) );
+        const __m256i block2 = FoldToLowerAvx2( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( str2 + i ) ) );
+        const auto    equal  = static_cast<uint32_t>( _mm256_movemask_epi8( _mm256_cmpeq_epi8( block1, block2 ) ) );
+        if ( equal != 0xFFFFFFFFu ) {
+            return i + static_cast<size_t>( __builtin_ctz( ~equal ) );
+        }
+    }
+    return i;
+}
+
+UTILS_TARGET_AVX2 bool FindIgnoreCaseAvx2( std::string_view str, std::string_view token, size_t &pos ) {
+    const size_t  last_offset = token.size() - 1;
+    const __m256i first       = _mm256_set1_epi8( AsciiToLower( token.front() ) );
+    const __m256i last        = _mm256_set1_epi8( AsciiToLower( token.back() ) );
+    size_t        i           = pos;
+    for ( ; i + last_offset + 32 <= str.size(); i += 32 ) {
+        const __m256i block_first =
+            FoldToLowerAvx2( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( str.data() + i ) ) );
+        const __m256i block_last =
+            FoldToLowerAvx2( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( str.data() + i + last_offset ) ) );
+        auto candidates = static_cast<uint32_t>( _mm256_movemask_epi8(
+            _mm256_and_si256( _mm256_cmpeq_epi8( block_first, first ), _mm256_cmpeq_epi8( block_last, last ) ) ) );
+        while ( candidates != 0 ) {
+            const size_t candidate = i + static_cast<size_t>( __builtin_ctz( candidates ) );
+            if ( StringUtil::EqualsIgnoreCase( str.substr( candidate + 1, token.size() - 1 ), token.substr( 1 ) ) ) {
+                pos = candidate;
+                return true;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+    pos = i;
+    return false;
+}
+#endif
+
+/// 根据CPU特性选择大小写转换内核，不支持时返回nullptr
+CaseConvertFunc SelectCaseConvert() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasAvx2() ) {
+        return CaseConvertAvx2;
+    }
+#endif
+    return nullptr;
+}
+
+/// 根据CPU特性选择忽略大小写比较内核，不支持时返回nullptr
+MismatchIgnoreCaseFunc SelectMismatchIgnoreCase() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasAvx2() ) {
+        return MismatchIgnoreCaseAvx2;
+    }
+#endif
+    return nullptr;
+}
+
+/// 根据CPU特性选择忽略大小写查找内核，不支持时返回nullptr
+FindIgnoreCaseFunc SelectFindIgnoreCase() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasAvx2() ) {
+        return FindIgnoreCaseAvx2;
+    }
+#endif
+    return nullptr;
+}
+
+/// 原地把 [first, first+25] 内的ASCII字母翻转大小写
+void ConvertCaseInPlace( std::string &str, char first ) noexcept {
+    static const CaseConvertFunc convert = SelectCaseConvert();
+
+    char  *data = str.data();
+    size_t i    = convert ? convert( data, str.size(), first ) : 0;
+    for ( ; i < str.size(); ++i ) {
+        if ( static_cast<unsigned char>( data[i] - first ) < 26 ) {
+            data[i] = static_cast<char>( data[i] ^ 0x20 );
+        }
+    }
+}
+
+/// 转义动作
+enum class EscapeAction : uint8_t {
+    kCopy,     ///< 原样复制
+    kLiteral,  ///< 替换为固定字符串
+    kHex,      ///< \xHH（大写）
+    kUnicode,  ///< \u00hh（小写）
+    kPercent,  ///< %HH（大写）
+};
+
+/// 一种转义方言的动作表
+struct EscapeTable {
+    CharSet          special;  ///< 动作不是 kCopy 的字节
+    EscapeAction     action[256]{};
+    std::string_view literal[256]{};
+    uint8_t          length[256]{};  ///< 每个字节的输出长度
+    std::string_view open;           ///< 需要整体包裹时的前后缀（shell）
+    std::string_view close;
+    CharSet          unsafe;  ///< open 非空时，空串或出现其中任一字节才需要包裹
+};
+
+EscapeTable MakeEscapeTable( EscapeDialect dialect ) {
+    EscapeTable table;
+    std::string special;
+    auto        set = [&]( unsigned char c, EscapeAction action, std::string_view literal = {} ) {
+        table.action[c]  = action;
+        table.literal[c] = literal;
+        switch ( action ) {
+            case EscapeAction::kCopy:
+                table.length[c] = 1;
+                return;
+            case EscapeAction::kLiteral:
+                table.length[c] = static_cast<uint8_t>( literal.size() );
+                break;
+            case EscapeAction::kHex:
+                table.length[c] = 4;
+                break;
+            case EscapeAction::kUnicode:
+                table.length[c] = 6;
+                break;
+            case EscapeAction::kPercent:
+                table.length[c] = 3;
+                break;
+        }
+        special.push_back( static_cast<char>( c ) );
+    };
+    for ( unsigned int c = 0; c < 256; ++c ) {
+        set( static_cast<unsigned char>( c ), EscapeAction::kCopy );
+    }
+
+    switch ( dialect ) {
+        case EscapeDialect::kC:
+            for ( unsigned int c = 0; c < 256; ++c ) {
+                if ( c < 32 || c > 126 ) {
+                    set( static_cast<unsigned char>( c ), EscapeAction::kHex );
+                }
+            }
+            set( '\n', EscapeAction::kLiteral, "\\n" );
+            set( '\r', EscapeAction::kLiteral, "\\r" );
+            set( '\t', EscapeAction::kLiteral, "\\t" );
+            set( '\\', EscapeAction::kLiteral, "\\\\" );
+            set( '"', EscapeAction::kLiteral, "\\\"" );
+            set( '\'', EscapeAction::kLiteral, "\\'" );
+            break;
+        case EscapeDialect::kJson:
+            for ( unsigned int c = 0; c < 32; ++c ) {
+                set( static_cast<unsigned char>( c ), EscapeAction::kUnicode );
+            }
+            set( '\b', EscapeAction::kLiteral, "\\b" );
+            set( '\f', EscapeAction::kLiteral, "\\f" );
+            set( '\n', EscapeAction::kLiteral, "\\n" );
+            set( '\r', EscapeAction::kLiteral, "\\r" );
+            set( '\t', EscapeAction::kLiteral, "\\t" );
+            set( '\\', EscapeAction::kLiteral, "\\\\" );
+            set( '"', EscapeAction::kLiteral, "\\\"" );
+            break;
+        case EscapeDialect::kUrl:
+            for ( unsigned int c = 0; c < 256; ++c ) {
+                const bool unreserved = ( c >= 'A' && c <= 'Z' ) || ( c >= 'a' && c <= 'z' ) ||
+                                        ( c >= '0' && c <= '9' ) || c == '-' || c == '_' || c == '.' || c == '~';
+                if ( !unreserved ) {
+                    set( static_cast<unsigned char>( c ), EscapeAction::kPercent );
+                }
+            }
+            break;
+        case EscapeDialect::kShell: {
+            // 只由安全字符组成的非空串原样输出，否则整体包裹在单引号中
+            std::string unsafe;
+            for ( unsigned int c = 0; c < 256; ++c ) {
+                const bool safe = ( c >= 'A' && c <= 'Z' ) || ( c >= 'a' && c <= 'z' ) || ( c >= '0' && c <= '9' ) ||
+                                  ( c != 0 && std::strchr( "@%+=:,./_-", static_cast<int>( c ) ) != nullptr );
+                if ( !safe ) {
+                    unsafe.push_back( static_cast<char>( c ) );
+                }
+            }
+            set( '\'', EscapeAction::kLiteral, "'\\''" );
+            table.open   = "'";
+            table.close  = "'";
+            table.unsafe = CharSet( unsafe );
+            break;
+        }
+    }
+    table.special = CharSet( special );
+    return table;
+}
+
+const EscapeTable &GetEscapeTable( EscapeDialect dialect ) {
+    static const EscapeTable tables[] = {
+        MakeEscapeTable( EscapeDialect::kC ),
+        MakeEscapeTable( EscapeDialect::kJson ),
+        MakeEscapeTable( EscapeDialect::kUrl ),
+        MakeEscapeTable( EscapeDialect::kShell ),
+    };
+    return tables[static_cast<size_t>( dialect )];
+}
+
+/// 按动作表转义：先统计输出长度，一次扩容后直接写入
+void EscapeWithTable( std::string &out, std::string_view str, const EscapeTable &table ) {
+    static constexpr char upper_hex[] = "0123456789ABCDEF";
+    static constexpr char lower_hex[] = "0123456789abcdef";
+
+    const bool wrap = !table.open.empty() && ( str.empty() || table.unsafe.FindFirst( str ) != std::string_view::npos );
+    if ( !wrap && !table.open.empty() ) {
+        out.append( str );
+        return;
+    }
+
+    size_t length = str.size();
+    for ( size_t pos = table.special.FindFirst( str ); pos != std::string_view::npos;
+          pos        = table.special.FindFirst( str, pos + 1 ) ) {
+        length += table.length[static_cast<unsigned char>( str[pos] )] - 1;
+    }
+    if ( wrap ) {
+        length += table.open.size() + table.close.size();
+    }
+
+    const size_t start = out.size();
+    out.resize( start + length );
+    char *dst = out.data() + start;
+    if ( wrap ) {
+        std::memcpy( dst, table.open.data(), table.open.size() );
+        dst += table.open.size();
+    }
+    size_t copied = 0;
+    for ( size_t pos = table.special.FindFirst( str ); pos != std::string_view::npos;
+          pos        = table.special.FindFirst( str, copied ) ) {
+        std::memcpy( dst, str.data() + copied, pos - copied );
+        dst += pos - copied;
+
+        const auto c = static_cast<unsigned char>( str[pos] );
+        switch ( table.action[c] ) {
+            case EscapeAction::kCopy:
+                *dst++ = static_cast<char>( c );
+                break;
+            case EscapeAction::kLiteral:
+                std::memcpy( dst, table.literal[c].data(), table.literal[c].size() );
+                dst += table.literal[c].size();
+                break;
+            case EscapeAction::kHex:
+                dst[0] = '\\', dst[1] = 'x', dst[2] = upper_hex[c >> 4], dst[3] = upper_hex[c & 0xF];
+                dst += 4;
+                break;
+            case EscapeAction::kUnicode:
+                std::memcpy( dst, "\\u00", 4 );
+                dst[4] = lower_hex[c >> 4], dst[5] = lower_hex[c & 0xF];
+                dst += 6;
+                break;
+            case EscapeAction::kPercent:
+                dst[0] = '%', dst[1] = upper_hex[c >> 4], dst[2] = upper_hex[c & 0xF];
+                dst += 3;
+                break;
+        }
+        copied = pos + 1;
+    }
+    std::memcpy( dst, str.data() + copied, str.size() - copied );
+    dst += str.size() - copied;
+    if ( wrap ) {
+        std::memcpy( dst, table.close.data(), table.close.size() );
+    }
+}
+
+/// 把码点编码为UTF-8追加到out
+void AppendUtf8( std::string &out, uint32_t code_point ) {
+    if ( code_point < 0x80 ) {
+        out += static_cast<char>( code_point );
+    }
+    else if ( code_point < 0x800 ) {
+        out += static_cast<char>( 0xC0 | ( code_point >> 6 ) );
+        out += static_cast<char>( 0x80 | ( code_point & 0x3F ) );
+    }
+    else if ( code_point < 0x10000 ) {
+        out += static_cast<char>( 0xE0 | ( code_point >> 12 ) );
+        out += static_cast<char>( 0x80 | ( ( code_point >> 6 ) & 0x3F ) );
+        out += static_cast<char>( 0x80 | ( code_point & 0x3F ) );
+    }
+    else {
+        out += static_cast<char>( 0xF0 | ( code_point >> 18 ) );
+        out += static_cast<char>( 0x80 | ( ( code_point >> 12 ) & 0x3F ) );
+        out += static_cast<char>( 0x80 | ( ( code_point >> 6 ) & 0x3F ) );
+        out += static_cast<char>( 0x80 | ( code_point & 0x3F ) );
+    }
+}
+
+/// 解析4位十六进制数，失败返回-1
+int32_t ParseHex4( std::string_view str, size_t pos ) noexcept {
+    if ( pos + 4 > str.size() ) {
+        return -1;
+    }
+    int32_t value = 0;
+    for ( size_t i = pos; i < pos + 4; ++i ) {
+        const int digit = HexDigitValue( str[i] );
+        if ( digit < 0 ) {
+            return -1;
+        }
+        value = ( value << 4 ) | digit;
+    }
+    return value;
+}
+
+bool UnescapeJson( std::string &out, std::string_view str ) {
+    out.reserve( out.size() + str.size() );
+    size_t i = 0;
+    while ( true ) {
+        const size_t backslash = str.find( '\\', i );
+        if ( backslash == std::string_view::npos ) {
+            out.append( str.data() + i, str.size() - i );
+            return true;
+        }
+        out.append( str.data() + i, backslash - i );
+        if ( backslash + 1 >= str.size() ) {
+            return false;
+        }
+        i = backslash + 2;
+        switch ( str[backslash + 1] ) {
+            case '"':
+                out += '"';
+                break;
+            case '\\':
+                out += '\\';
+                break;
+            case '/':
+                out += '/';
+                break;
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+            case 'u': {
+                int32_t code = ParseHex4( str, i );
+                if ( code < 0 || ( code >= 0xDC00 && code <= 0xDFFF ) ) {
+                    return false;
+                }
+                i += 4;
+                if ( code >= 0xD800 && code <= 0xDBFF ) {
+                    // 高代理项后必须紧跟低代理项
+                    if ( i + 2 > str.size() || str[i] != '\\' || str[i + 1] != 'u' ) {
+                        return false;
+                    }
+                    const int32_t low = ParseHex4( str, i + 2 );
+                    if ( low < 0xDC00 || low > 0xDFFF ) {
+                        return false;
+                    }
+                    code = 0x10000 + ( ( code - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+                    i += 6;
+                }
+                AppendUtf8( out, static_cast<uint32_t>( code ) );
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+}
+
+bool UnescapeUrl( std::string &out, std::string_view str ) {
+    out.reserve( out.size() + str.size() );
+    size_t i = 0;
+    while ( true ) {
+        const size_t percent = str.find( '%', i );
+        if ( percent == std::string_view::npos ) {
+            out.append( str.data() + i, str.size() - i );
+            return true;
+        }
+        out.append( str.data() + i, percent - i );
+        if ( percent + 2 >= str.size() ) {
+            return false;
+        }
+        const int high = HexDigitValue( str[percent + 1] );
+        const int low  = HexDigitValue( str[percent + 2] );
+        if ( high < 0 || low < 0 ) {
+            return false;
+        }
+        out += static_cast<char>( ( high << 4 ) | low );
+        i = percent + 3;
+    }
+}
+
+bool UnescapeShell( std::string &out, std::string_view str ) {
+    out.reserve( out.size() + str.size() );
+    size_t i = 0;
+    while ( i < str.size() ) {
+        const char c = str[i];
+        if ( c == '\'' ) {
+            // 单引号内没有任何转义
+            const size_t close = str.find( '\'', i + 1 );
+            if ( close == std::string_view::npos ) {
+                return false;
+            }
+            out.append( str.data() + i + 1, close - i - 1 );
+            i = close + 1;
+        }
+        else if ( c == '"' ) {
+            // 双引号内反斜杠只转义 $ ` " \ 和换行
+            ++i;
+            while ( true ) {
+                if ( i >= str.size() ) {
+                    return false;
+                }
+                const char d = str[i];
+                if ( d == '"' ) {
+                    ++i;
+                    break;
+                }
+                if ( d == '\\' && i + 1 < str.size() && std::strchr( "$`\"\\\n", str[i + 1] ) ) {
+                    if ( str[i + 1] != '\n' ) {
+                        out += str[i + 1];
+                    }
+                    i += 2;
+                    continue;
+                }
+                out += d;
+                ++i;
+            }
+        }
+        else if ( c == '\\' ) {
+            if ( i + 1 >= str.size() ) {
+                return false;
+            }
+            if ( str[i + 1] != '\n' ) {
+                out += str[i + 1];
+            }
+            i += 2;
+        }
+        else {
+            out += c;
+            ++i;
+        }
+    }
+    return true;
+}
+
+const CharSet &BlankCharSet() noexcept {
+    static const CharSet blank( " \n\r\t\v\f" );
+    return blank;
+}
+
+/// 判断view是否引用了str的存储
+inline bool Overlaps( const std::string &str, std::string_view view ) noexcept {
+    const auto begin = reinterpret_cast<uintptr_t>( str.data() );
+    const auto ptr   = reinterpret_cast<uintptr_t>( view.data() );
+    return !view.empty() && ptr >= begin && ptr < begin + str.size();
+}
+
+/// 将str[last, pos)作为一个子串加入结果
+inline void EmitPiece( std::string_view str, size_t last, size_t pos, bool skip_empty,
+                       std::vector<std::string_view> &result ) {
+    if ( !skip_empty || pos != last ) {
+        result.emplace_back( str.data() + last, pos - last );
+    }
+}
+
+/// 单字节分隔符分割（标量版本）
+[[maybe_unused]] void SplitByteScalar( std::string_view str, char sep, bool skip_empty,
+                                       std::vector<std::string_view> &result ) {
+    size_t last = 0;
+    for ( size_t i = 0; i < str.size(); ++i ) {
+        if ( str[i] == sep ) {
+            EmitPiece( str, last, i, skip_empty, result );
+            last = i + 1;
+        }
+    }
+    EmitPiece( str, last, str.size(), skip_empty, result );
+}
+
+#ifdef UTILS_STRING_SIMD_X86
+/// 单字节分隔符分割（SSE2版本，每次比较16字节，逐位取出分隔符位置）
+void SplitByteSse2( std::string_view str, char sep, bool skip_empty, std::vector<std::string_view> &result ) {
+    const char   *data   = str.data();
+    const size_t  size   = str.size();
+    const __m128i needle = _mm_set1_epi8( sep );
+    size_t        last   = 0;
+    size_t        i      = 0;
+    for ( ; i + 16 <= size; i += 16 ) {
+        const __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i *>( data + i ) );
+        auto          mask  = static_cast<uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( block, needle ) ) );
+        while ( mask != 0 ) {
+            const size_t pos = i + static_cast<size_t>( __builtin_ctz( mask ) );
+            EmitPiece( str, last, pos, skip_empty, result );
+            last = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    for ( ; i < size; ++i ) {
+        if ( data[i] == sep ) {
+            EmitPiece( str, last, i, skip_empty, result );
+            last = i + 1;
+        }
+    }
+    EmitPiece( str, last, size, skip_empty, result );
+}
+
+/// 单字节分隔符分割（AVX2版本，每次比较32字节）
+UTILS_TARGET_AVX2 void SplitByteAvx2( std::string_view str, char sep, bool skip_empty,
+                                      std::vector<std::string_view> &result ) {
+    const char   *data   = str.data();
+    const size_t  size   = str.size();
+    const __m256i needle = _mm256_set1_epi8( sep );
+    size_t        last   = 0;
+    size_t        i      = 0;
+    for ( ; i + 32 <= size; i += 32 ) {
+        const __m256i block = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + i ) );
+        auto          mask  = static_cast<uint32_t>( _mm256_movemask_epi8( _mm256_cmpeq_epi8( block, needle ) ) );
+        while ( mask != 0 ) {
+            const size_t pos = i + static_cast<size_t>( __builtin_ctz( mask ) );
+            EmitPiece( str, last, pos, skip_empty, result );
+            last = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    for ( ; i < size; ++i ) {
+        if ( data[i] == sep ) {
+            EmitPiece( str, last, i, skip_empty, result );
+            last = i + 1;
+        }
+    }
+    EmitPiece( str, last, size, skip_empty, result );
+}
+#endif
+
+using SplitByteFunc = void ( * )( std::string_view, char, bool, std::vector<std::string_view> & );
+
+/// 根据CPU特性选择单字节分割实现
+SplitByteFunc SelectSplitByte() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    return CpuHasAvx2() ? SplitByteAvx2 : SplitByteSse2;
+#else
+    return SplitByteScalar;
+#endif
+}
+
+/// 在 data[pos] 处校验各关键字，返回最长的一个在 needles 中的下标，无匹配时返回 npos
+size_t MatchNeedlesAt( const char *data, size_t size, size_t pos, const std::string *needles, size_t count,
+                       uint32_t candidates = UINT32_MAX ) noexcept {
+    size_t best = std::string_view::npos;
+    for ( size_t k = 0; k < count; ++k ) {
+        const std::string &needle = needles[k];
+        if ( ( candidates >> k & 1 ) == 0 || needle.size() > size - pos ) {
+            continue;
+        }
+        if ( ( best == std::string_view::npos || needle.size() > needles[best].size() ) &&
+             std::memcmp( data + pos, needle.data(), needle.size() ) == 0 ) {
+            best = k;
+        }
+    }
+    return best;
+}
+
+/**
+ * 多关键字首尾字节过滤内核：每次处理32个起始位置，对每个关键字比较首字节和末字节，
+ * 两者都命中的位置才逐一校验。找到匹配时写入 found_pos/found_index 并返回 true；
+ * 否则在 pos 中返回尚未扫描的尾部起点，由调用方逐字节处理。
+ */
+using FindNeedlesFunc = bool ( * )( const char *, size_t, const std::string *, size_t, size_t, size_t &, size_t & );
+
+#ifdef UTILS_STRING_SIMD_X86
+UTILS_TARGET_AVX2 bool FindNeedlesAvx2( const char *data, size_t size, const std::string *needles, size_t count,
+                                        size_t max_length, size_t &pos, size_t &found_index ) {
+    __m256i first[NeedleSet::kMaxPackedNeedles];
+    __m256i last[NeedleSet::kMaxPackedNeedles];
+    for ( size_t k = 0; k < count; ++k ) {
+        first[k] = _mm256_set1_epi8( needles[k].front() );
+        last[k]  = _mm256_set1_epi8( needles[k].back() );
+    }
+
+    for ( ; pos + 32 + max_length - 1 <= size; pos += 32 ) {
+        const __m256i block = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( data + pos ) );
+        uint32_t      masks[NeedleSet::kMaxPackedNeedles];
+        uint32_t      any = 0;
+        for ( size_t k = 0; k < count; ++k ) {
+            const __m256i tail = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>( data + pos + needles[k].size() - 1 ) );
+            masks[k] = static_cast<uint32_t>( _mm256_movemask_epi8(
+                _mm256_and_si256( _mm256_cmpeq_epi8( block, first[k] ), _mm256_cmpeq_epi8( tail, last[k] ) ) ) );
+            any |= masks[k];
+        }
+        while ( any != 0 ) {
+            const int bit        = __builtin_ctz( any );
+            uint32_t  candidates = 0;
+            for ( size_t k = 0; k < count; ++k ) {
+                candidates |= ( masks[k] >> bit & 1 ) << k;
+            }
+            const size_t index = MatchNeedlesAt( data, size, pos + bit, needles, count, candidates );
+            if ( index != std::string_view::npos ) {
+                pos += bit;
+                found_index = index;
+                return true;
+            }
+            any &= any - 1;
+        }
+    }
+    return false;
+}
+#endif
+
+/// 根据CPU特性选择多关键字过滤实现，不支持时返回nullptr（改用 Aho-Corasick）
+FindNeedlesFunc SelectFindNeedles() noexcept {
+#ifdef UTILS_STRING_SIMD_X86
+    if ( CpuHasAvx2() ) {
+        return FindNeedlesAvx2;
+    }
+#endif
+    return nullptr;
+}
+
+}  // namespace
+
+CharSet::CharSet( std::string_view chars ) noexcept {
+    for ( const char c : chars ) {
+        const auto uc = static_cast<unsigned char>( c );
+        bits_[uc >> 6] |= uint64_t{ 1 } << ( uc & 63 );
+    }
+    Compile();
+}
+
+CharSet CharSet::Range( unsigned char first, unsigned char last ) noexcept {
+    CharSet set;
+    for ( unsigned int c = first; c <= last; ++c ) {
+        set.bits_[c >> 6] |= uint64_t{ 1 } << ( c & 63 );
+    }
+    set.Compile();
+    return set;
+}
+
+CharSet CharSet::operator|( const CharSet &other ) const noexcept {
+    CharSet set;
+    for ( size_t i = 0; i < 4; ++i ) {
+        set.bits_[i] = bits_[i] | other.bits_[i];
+    }
+    set.Compile();
+    return set;
+}
+
+void CharSet::Compile() noexcept {
+    // 按高半字节分组，每组的低半字节集合是一个16位掩码；
+    // 相同掩码共享一个桶，不超过8个桶时可用两次PSHUFB精确分类
+    uint16_t bucket_masks[8]{};
+    size_t   bucket_count = 0;
+    std::fill( std::begin( lo_nibble_ ), std::end( lo_nibble_ ), uint8_t{ 0 } );
+    std::fill( std::begin( hi_nibble_ ), std::end( hi_nibble_ ), uint8_t{ 0 } );
+    simd_ = false;
+
+    for ( unsigned int hi = 0; hi < 16; ++hi ) {
+        uint16_t low_mask = 0;
+        for ( unsigned int lo = 0; lo < 16; ++lo ) {
+            if ( Contains( static_cast<char>( ( hi << 4 ) | lo ) ) ) {
+                low_mask |= static_cast<uint16_t>( 1u << lo );
+            }
+        }
+        if ( low_mask == 0 ) {
+            continue;
+        }
+        size_t bucket = 0;
+        while ( bucket < bucket_count && bucket_masks[bucket] != low_mask ) {
+            ++bucket;
+        }
+        if ( bucket == bucket_count ) {
+            if ( bucket_count == 8 ) {
+                return;  // 无法精确表示，仅使用位图
+            }
+            bucket_masks[bucket_count++] = low_mask;
+        }
+        hi_nibble_[hi] |= static_cast<uint8_t>( 1u << bucket );
+    }
+    for ( size_t bucket = 0; bucket < bucket_count; ++bucket ) {
+        for ( unsigned int lo = 0; lo < 16; ++lo ) {
+            if ( bucket_masks[bucket] & ( 1u << lo ) ) {
+                lo_nibble_[lo] |= static_cast<uint8_t>( 1u << bucket );
+            }
+        }
+    }
+    simd_ = true;
+}
+
+size_t CharSet::Find( std::string_view str, size_t pos, bool negate ) const noexcept {
+    if ( pos >= str.size() ) {
+        return std::string_view::npos;
+    }
+    const char  *data = str.data() + pos;
+    const size_t size = str.size() - pos;
+    size_t       i    = 0;
+    if ( simd_ ) {
+        static const CharSetScanFunc scan = SelectCharSetScan();
+        if ( scan != nullptr ) {
+            i = scan( data, size, lo_nibble_, hi_nibble_, negate );
+        }
+    }
+    for ( ; i < size; ++i ) {
+        if ( Contains( data[i] ) != negate ) {
+            return pos + i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+size_t CharSet::FindFirst( std::string_view str, size_t pos ) const noexcept {
+    return Find( str, pos, false );
+}
+
+size_t CharSet::FindFirstNot( std::string_view str, size_t pos ) const noexcept {
+    return Find( str, pos, true );
+}
+
+size_t CharSet::FindLastNot( std::string_view str ) const noexcept {
+    for ( size_t i = str.size(); i > 0; --i ) {
+        if ( !Contains( str[i - 1] ) ) {
+            return i - 1;
+        }
+    }
+    return std::string_view::npos;
+}
+
 void StringUtil::ClearError( std::string *error_msg ) noexcept {
     if ( error_msg ) {
         error_msg->clear();
@@ -37,10 +1187,10 @@ std::vector<std::string> StringUtil::Split( std::string_view str, std::string_vi
 std::vector<std::string_view> StringUtil::SplitRef( std::string_view str, std::string_view separator, bool skip_empty,
                                                     bool each_char_as_separator ) noexcept {
     std::vector<std::string_view> result;
-    result.reserve( str.size() + 2 );  // 空separator时最大可能N+2个元素
 
     // 分隔符为空时，返回每个字符的子串
     if ( separator.empty() ) {
+        result.reserve( str.size() + 2 );  // 最多N+2个元素
         if ( !skip_empty ) {
             result.emplace_back( "" );
         }
@@ -53,21 +1203,24 @@ std::vector<std::string_view> StringUtil::SplitRef( std::string_view str, std::s
         return result;
     }
 
+    // 单字节分隔符（两种模式语义相同），走向量化快速路径
+    if ( separator.size() == 1 ) {
+        static const SplitByteFunc split_byte = SelectSplitByte();
+        split_byte( str, separator[0], skip_empty, result );
+        return result;
+    }
+
     // 字符分隔符模式，将separator中的每个字符都作为独立的分隔符
     if ( each_char_as_separator ) {
-        size_t last_pos = 0;
-
-        for ( size_t i = 0; i <= str.size(); ++i ) {
-            if ( i == str.size() || separator.find( str[i] ) != std::string_view::npos ) {
-                std::string_view part = str.substr( last_pos, i - last_pos );
-                // 根据skip_empty参数决定是否添加空字符串
-                if ( !skip_empty || !part.empty() ) {
-                    result.emplace_back( part );
-                }
+        const CharSet separator_set( separator );
+        size_t        last_pos = 0;
+        size_t        found    = 0;
 
-                last_pos = i + 1;
-            }
+        while ( ( found = separator_set.FindFirst( str, last_pos ) ) != std::string_view::npos ) {
+            EmitPiece( str, last_pos, found, skip_empty, result );
+            last_pos = found + 1;
         }
+        EmitPiece( str, last_pos, str.size(), skip_empty, result );
 
         return result;
     }
@@ -115,146 +1268,281 @@ std::string StringUtil::ReplaceAll( std::string_view str, std::string_view from,
     }
 
     std::string result;
-    size_t      start_pos = 0;
-    size_t      found_pos;
+    if ( to.length() <= from.length() ) {
+        // 结果不会比源字符串长，无需预先统计匹配数量
+        result.reserve( str.length() );
+    }
+    else {
+        size_t count = 0;
+        size_t pos   = 0;
+        size_t found_pos;
+        while ( ( found_pos = str.find( from, pos ) ) != std::string_view::npos ) {
+            ++count;
+            pos = found_pos + from.length();
+        }
+        result.reserve( str.length() + count * ( to.length() - from.length() ) );
+    }
+    AppendReplaced( result, str, from, to );
+    return result;
+}
+
+bool StringUtil::ReplaceFirstInPlace( std::string &str, std::string_view from, std::string_view to ) {
+    if ( from.empty() ) {
+        return false;
+    }
+    const size_t pos = str.find( from );
+    if ( pos == std::string::npos ) {
+        return false;
+    }
+    if ( Overlaps( str, to ) ) {
+        str.replace( pos, from.length(), std::string( to ) );
+    }
+    else {
+        str.replace( pos, from.length(), to );
+    }
+    return true;
+}
+
+size_t StringUtil::ReplaceAllInPlace( std::string &str, std::string_view from, std::string_view to ) {
+    if ( from.empty() ) {
+        return 0;
+    }
+    // from/to引用str自身时，原地修改会破坏它们，先复制
+    if ( Overlaps( str, from ) || Overlaps( str, to ) ) {
+        const std::string from_copy( from );
+        const std::string to_copy( to );
+        return ReplaceAllInPlace( str, from_copy, to_copy );
+    }
+
+    const size_t from_len = from.length();
+    const size_t to_len   = to.length();
+    size_t       count    = 0;
+    size_t       found    = 0;
+
+    if ( to_len <= from_len ) {
+        // 写指针永远不会超过读指针，前向压缩即可
+        char  *data  = str.data();
+        size_t read  = 0;
+        size_t write = 0;
+        while ( ( found = str.find( from, read ) ) != std::string::npos ) {
+            if ( write != read ) {
+                std::memmove( data + write, data + read, found - read );
+            }
+            write += found - read;
+            std::memcpy( data + write, to.data(), to_len );
+            write += to_len;
+            read = found + from_len;
+            ++count;
+        }
+        if ( count == 0 ) {
+            return 0;
+        }
+        if ( write != read ) {
+            std::memmove( data + write, data + read, str.size() - read );
+        }
+        str.resize( write + str.size() - read );
+        return count;
+    }
+
+    // 结果变长：统计匹配位置后一次性扩容，再从尾部向前移动
+    std::vector<size_t> positions;
+    size_t              pos = 0;
+    while ( ( found = str.find( from, pos ) ) != std::string::npos ) {
+        positions.push_back( found );
+        pos = found + from_len;
+    }
+    if ( positions.empty() ) {
+        return 0;
+    }
+    const size_t old_size = str.size();
+    str.resize( old_size + positions.size() * ( to_len - from_len ) );
+    char  *data  = str.data();
+    size_t read  = old_size;
+    size_t write = str.size();
+    for ( auto iter = positions.rbegin(); iter != positions.rend(); ++iter ) {
+        const size_t tail = read - ( *iter + from_len );
+        write -= tail;
+        std::memmove( data + write, data + *iter + from_len, tail );
+        write -= to_len;
+        std::memcpy( data + write, to.data(), to_len );
+        read = *iter;
+    }
+    return positions.size();
+}
+
+size_t StringUtil::AppendReplaced( std::string &out, std::string_view str, std::string_view from,
+                                   std::string_view to ) {
+    if ( from.empty() ) {
+        out.append( str );
+        return 0;
+    }
 
-    // 预估最小容量
     size_t count = 0;
-    size_t pos   = 0;
-    while ( ( found_pos = str.find( from, pos ) ) != std::string_view::npos ) {
+    size_t start = 0;
+    size_t found = 0;
+    while ( ( found = str.find( from, start ) ) != std::string_view::npos ) {
+        out.append( str.data() + start, found - start );
+        out.append( to );
+        start = found + from.length();
         ++count;
-        pos = found_pos + from.length();
     }
-    result.reserve( str.length() + count * ( to.length() - from.length() ) );
+    out.append( str.data() + start, str.size() - start );
+    return count;
+}
+
+void NeedleSet::Build( const std::vector<std::string_view> &needles ) {
+    needles_.assign( needles.begin(), needles.end() );
+    matcher_ = AhoCorasick( needles_ );
 
-    while ( ( found_pos = str.find( from, start_pos ) ) != std::string_view::npos ) {
-        result.append( str.substr( start_pos, found_pos - start_pos ) );
-        result.append( to );
-        start_pos = found_pos + from.length();
+    for ( size_t id = 0; id < needles_.size(); ++id ) {
+        const std::string_view needle = needles_[id];
+        if ( needle.empty() || std::find( packed_.begin(), packed_.end(), needle ) != packed_.end() ) {
+            continue;
+        }
+        // 超过上限时不使用首尾字节过滤，停止收集，去重的开销不随关键字数量增长
+        if ( packed_.size() == kMaxPackedNeedles ) {
+            packed_.clear();
+            packed_ids_.clear();
+            packed_max_length_ = 0;
+            return;
+        }
+        packed_.emplace_back( needle );
+        packed_ids_.push_back( static_cast<uint32_t>( id ) );
+        packed_max_length_ = std::max( packed_max_length_, needle.size() );
     }
-    result.append( str.substr( start_pos ) );
+}
 
+std::string StringUtil::ReplaceMany( std::string_view str, const ReplaceSet &replacements ) {
+    const AhoCorasick &matcher = replacements.Matcher();
+
+    std::string result;
+    result.reserve( str.size() );
+    size_t copied = 0;
+    matcher.ForEachMatch( str, [&]( const AhoCorasick::Match &match ) {
+        result.append( str.data() + copied, match.offset - copied );
+        result.append( replacements.Replacement( match.pattern ) );
+        copied = match.offset + match.length;
+    } );
+    result.append( str.data() + copied, str.size() - copied );
     return result;
 }
 
 std::string StringUtil::EscapeC( std::string_view str ) noexcept {
     std::string result;
-    result.reserve( str.length() * 2 );  // 极端情况下每个字符都转义成多个
+    AppendEscapedC( result, str );
+    return result;
+}
+
+void StringUtil::AppendEscapedC( std::string &out, std::string_view str ) {
+    AppendEscaped( out, str, EscapeDialect::kC );
+}
+
+std::string StringUtil::UnescapeC( std::string_view str ) noexcept {
+    std::string result;
+    AppendUnescapedC( result, str );
+    return result;
+}
 
-    for ( const unsigned char c : str ) {
-        switch ( c ) {
-            case '\n':
-                result += "\\n";
+void StringUtil::AppendUnescapedC( std::string &out, std::string_view str ) {
+    out.reserve( out.size() + str.size() );
+    size_t i = 0;
+    while ( i < str.length() ) {
+        // 反斜杠之前的部分整段复制（find 基于 memchr，已向量化）
+        const size_t backslash = str.find( '\\', i );
+        if ( backslash == std::string_view::npos || backslash + 1 >= str.length() ) {
+            out.append( str.data() + i, str.length() - i );
+            return;
+        }
+        out.append( str.data() + i, backslash - i );
+        i = backslash + 1;
+
+        const char next = str[i];
+        switch ( next ) {
+            case 'n':
+                out += '\n';
                 break;
-            case '\r':
-                result += "\\r";
+            case 'r':
+                out += '\r';
                 break;
-            case '\t':
-                result += "\\t";
+            case 't':
+                out += '\t';
                 break;
             case '\\':
-                result += "\\\\";
+                out += '\\';
                 break;
-            case '\"':
-                result += "\\\"";
+            case '"':
+                out += '"';
                 break;
             case '\'':
-                result += "\\\'";
+                out += '\'';
                 break;
-            default:
-                if ( c < 32 || c > 126 ) {
-                    result += "\\x";
-                    const char hex[] = "0123456789ABCDEF";
-                    result += hex[( c >> 4 ) & 0xF];
-                    result += hex[c & 0xF];
+            case 'x':
+                if ( i + 2 < str.length() ) {
+                    const int high = HexDigitValue( str[i + 1] );
+                    const int low  = HexDigitValue( str[i + 2] );
+                    if ( high >= 0 && low >= 0 ) {
+                        out += static_cast<char>( ( high << 4 ) | low );
+                    }
+                    else {
+                        out.append( str.data() + i - 1, 4 );
+                    }
+                    i += 2;
                 }
                 else {
-                    result += static_cast<char>( c );
+                    out += "\\x";
                 }
                 break;
+            default:
+                out += '\\';
+                out += next;
+                break;
         }
+        ++i;
     }
+}
 
+std::string StringUtil::Escape( std::string_view str, EscapeDialect dialect ) {
+    std::string result;
+    AppendEscaped( result, str, dialect );
     return result;
 }
 
-std::string StringUtil::UnescapeC( std::string_view str ) noexcept {
+void StringUtil::AppendEscaped( std::string &out, std::string_view str, EscapeDialect dialect ) {
+    EscapeWithTable( out, str, GetEscapeTable( dialect ) );
+}
+
+std::optional<std::string> StringUtil::Unescape( std::string_view str, EscapeDialect dialect ) {
     std::string result;
-    result.reserve( str.length() );
-
-    for ( size_t i = 0; i < str.length(); ++i ) {
-        char c = str[i];
-        if ( c == '\\' && i + 1 < str.length() ) {
-            char next = str[++i];
-            switch ( next ) {
-                case 'n':
-                    result += '\n';
-                    break;
-                case 'r':
-                    result += '\r';
-                    break;
-                case 't':
-                    result += '\t';
-                    break;
-                case '\\':
-                    result += '\\';
-                    break;
-                case '"':
-                    result += '"';
-                    break;
-                case '\'':
-                    result += '\'';
-                    break;
-                case 'x':
-                    if ( i + 2 < str.length() ) {
-                        char h1 = str[++i], h2 = str[++i];
-                        int  val   = 0;
-                        bool valid = true;
-                        if ( h1 >= '0' && h1 <= '9' )
-                            val = ( h1 - '0' ) << 4;
-                        else if ( h1 >= 'A' && h1 <= 'F' )
-                            val = ( h1 - 'A' + 10 ) << 4;
-                        else if ( h1 >= 'a' && h1 <= 'f' )
-                            val = ( h1 - 'a' + 10 ) << 4;
-                        else
-                            valid = false;
-
-                        if ( h2 >= '0' && h2 <= '9' )
-                            val |= ( h2 - '0' );
-                        else if ( h2 >= 'A' && h2 <= 'F' )
-                            val |= ( h2 - 'A' + 10 );
-                        else if ( h2 >= 'a' && h2 <= 'f' )
-                            val |= ( h2 - 'a' + 10 );
-                        else
-                            valid = false;
-
-                        if ( valid ) {
-                            result += static_cast<char>( val );
-                        }
-                        else {
-                            result += "\\x";
-                            result += h1;
-                            result += h2;
-                        }
-                    }
-                    else {
-                        result += "\\x";
-                    }
-                    break;
-                default:
-                    result += '\\';
-                    result += next;
-                    break;
-            }
-        }
-        else {
-            result += c;
-        }
+    if ( !AppendUnescaped( result, str, dialect ) ) {
+        return std::nullopt;
     }
-
     return result;
 }
 
+bool StringUtil::AppendUnescaped( std::string &out, std::string_view str, EscapeDialect dialect ) {
+    const size_t start = out.size();
+    bool         ok    = true;
+    switch ( dialect ) {
+        case EscapeDialect::kC:
+            AppendUnescapedC( out, str );
+            break;
+        case EscapeDialect::kJson:
+            ok = UnescapeJson( out, str );
+            break;
+        case EscapeDialect::kUrl:
+            ok = UnescapeUrl( out, str );
+            break;
+        case EscapeDialect::kShell:
+            ok = UnescapeShell( out, str );
+            break;
+    }
+    // 失败时不留下部分结果
+    if ( !ok ) {
+        out.resize( start );
+    }
+    return ok;
+}
+
 bool StringUtil::WildcardMatch( std::string_view str, std::string_view pattern ) noexcept {
     size_t s = 0, p = 0;
     size_t star_idx = std::string_view::npos, ss_idx = std::string_view::npos;
@@ -292,6 +1580,141 @@ bool StringUtil::WildcardMatch( std::string_view str, std::string_view pattern )
     return p == pattern.length();
 }
 
+WildcardPattern::WildcardPattern( std::string_view pattern ) : pattern_( pattern ) {
+    leading_star_  = !pattern_.empty() && pattern_.front() == '*';
+    trailing_star_ = !pattern_.empty() && pattern_.back() == '*';
+
+    size_t pos = 0;
+    while ( pos < pattern_.size() ) {
+        if ( pattern_[pos] == '*' ) {
+            ++pos;
+            continue;
+        }
+        const size_t end = std::min( pattern_.find( '*', pos ), pattern_.size() );
+        Segment      segment{ pos, end - pos, 0, 0, false };
+        // 找出片段内最长的字面量
+        size_t run_start = pos;
+        for ( size_t i = pos; i <= end; ++i ) {
+            if ( i == end || pattern_[i] == '?' ) {
+                if ( i - run_start > segment.anchor_length ) {
+                    segment.anchor_offset = run_start - pos;
+                    segment.anchor_length = i - run_start;
+                }
+                run_start = i + 1;
+                segment.has_question |= i != end;
+            }
+        }
+        min_length_ += segment.length;
+        segments_.push_back( segment );
+        pos = end;
+    }
+
+    const bool has_star = leading_star_ || trailing_star_ || segments_.size() > 1;
+    if ( segments_.empty() ) {
+        kind_ = has_star ? Kind::kAny : Kind::kLiteral;
+    }
+    else if ( !has_star ) {
+        kind_ = segments_[0].has_question ? Kind::kExact : Kind::kLiteral;
+    }
+    else if ( segments_.size() == 1 && !segments_[0].has_question && leading_star_ != trailing_star_ ) {
+        kind_ = trailing_star_ ? Kind::kPrefix : Kind::kSuffix;
+    }
+    else {
+        kind_ = Kind::kGeneral;
+    }
+}
+
+bool WildcardPattern::SegmentMatchAt( const Segment &segment, std::string_view str, size_t pos ) const noexcept {
+    const char *pat  = pattern_.data() + segment.offset;
+    const char *text = str.data() + pos;
+    if ( !segment.has_question ) {
+        return std::memcmp( pat, text, segment.length ) == 0;
+    }
+    for ( size_t i = 0; i < segment.length; ++i ) {
+        if ( pat[i] != '?' && pat[i] != text[i] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t WildcardPattern::FindSegment( const Segment &segment, std::string_view str, size_t begin,
+                                     size_t end ) const noexcept {
+    if ( end < begin || end - begin < segment.length ) {
+        return std::string_view::npos;
+    }
+    if ( segment.anchor_length == 0 ) {
+        // 全部为 '?'，任意位置都可匹配
+        return begin;
+    }
+    // 先用字面量定位候选位置，再校验整个片段
+    const std::string_view window = str.substr( 0, end );
+    const std::string_view anchor = View( segment.offset + segment.anchor_offset, segment.anchor_length );
+    const size_t           last   = end - segment.length;
+    size_t                 search = begin + segment.anchor_offset;
+    size_t                 found  = 0;
+    while ( ( found = window.find( anchor, search ) ) != std::string_view::npos ) {
+        const size_t start = found - segment.anchor_offset;
+        if ( start > last ) {
+            break;
+        }
+        if ( !segment.has_question || SegmentMatchAt( segment, str, start ) ) {
+            return start;
+        }
+        search = found + 1;
+    }
+    return std::string_view::npos;
+}
+
+bool WildcardPattern::Match( std::string_view str ) const noexcept {
+    switch ( kind_ ) {
+        case Kind::kAny:
+            return true;
+        case Kind::kLiteral:
+            return str == pattern_;
+        case Kind::kExact:
+            return str.size() == min_length_ && SegmentMatchAt( segments_[0], str, 0 );
+        case Kind::kPrefix:
+            return str.size() >= min_length_ && SegmentMatchAt( segments_[0], str, 0 );
+        case Kind::kSuffix:
+            return str.size() >= min_length_ && SegmentMatchAt( segments_[0], str, str.size() - min_length_ );
+        case Kind::kGeneral:
+            break;
+    }
+
+    if ( str.size() < min_length_ ) {
+        return false;
+    }
+    size_t begin = 0;
+    size_t end   = str.size();
+    size_t first = 0;
+    size_t last  = segments_.size();
+    // 首尾片段必须锚定在字符串两端
+    if ( !leading_star_ ) {
+        if ( !SegmentMatchAt( segments_[first], str, 0 ) ) {
+            return false;
+        }
+        begin = segments_[first].length;
+        ++first;
+    }
+    if ( !trailing_star_ ) {
+        --last;
+        end -= segments_[last].length;
+        if ( !SegmentMatchAt( segments_[last], str, end ) ) {
+            return false;
+        }
+    }
+    // 中间片段按顺序取最左匹配即可，无需回溯
+    for ( size_t i = first; i < last; ++i ) {
+        const size_t pos = FindSegment( segments_[i], str, begin, end );
+        if ( pos == std::string_view::npos ) {
+            return false;
+        }
+        begin = pos + segments_[i].length;
+    }
+    return true;
+}
+
 double StringUtil::ConvertByteUnit( double value, std::string_view from_unit, std::string_view to_unit ) noexcept {
     if ( value == 0.0 ) {
         return 0.0;
@@ -421,50 +1844,56 @@ std::string_view StringUtil::RightRef( std::string_view str, size_t len ) noexce
 }
 
 std::string StringUtil::Trim( std::string_view str ) noexcept {
-    std::string blank = " \n\r\t\v\f";
-    size_t      begin = str.size(), end = 0;
-    for ( size_t i = 0; i < str.size(); ++i ) {
-        if ( blank.find( str[i] ) == std::string::npos ) {
-            begin = i;
-            break;
-        }
-    }
+    return std::string( TrimRef( str ) );
+}
 
-    for ( size_t i = str.size(); i > 0; --i ) {
-        if ( blank.find( str[i - 1] ) == std::string::npos ) {
-            end = i - 1;
-            break;
-        }
-    }
+std::string_view StringUtil::TrimRef( std::string_view str ) noexcept {
+    return TrimRightRef( TrimLeftRef( str ) );
+}
 
-    if ( begin >= end ) {
-        return "";
+std::string_view StringUtil::TrimLeftRef( std::string_view str ) noexcept {
+    // 数值字段等短字符串通常无需裁剪，先检查首字节避免进入扫描
+    if ( str.empty() || !BlankCharSet().Contains( str.front() ) ) {
+        return str;
     }
-    else {
-        return std::string( str.substr( begin, end - begin + 1 ) );
+    const size_t begin = BlankCharSet().FindFirstNot( str );
+    return begin == std::string_view::npos ? str.substr( str.size() ) : str.substr( begin );
+}
+
+std::string_view StringUtil::TrimRightRef( std::string_view str ) noexcept {
+    if ( str.empty() || !BlankCharSet().Contains( str.back() ) ) {
+        return str;
     }
+    const size_t end = BlankCharSet().FindLastNot( str );
+    return end == std::string_view::npos ? str.substr( str.size() ) : str.substr( 0, end + 1 );
 }
 
 std::string StringUtil::Repeat( std::string_view str, unsigned int times ) {
-    std::stringstream ss;
-    for ( unsigned int i = 0; i < times; ++i ) {
-        ss << str;
-    }
-    return ss.str();
+    StringBuilder builder;
+    builder.AppendRepeated( str, times );
+    return std::move( builder ).ToString();
 }
 
 std::string StringUtil::ToUpper( std::string_view str ) {
     std::string s( str );
-    std::transform( s.begin(), s.end(), s.begin(), ::toupper );
+    ToUpperInPlace( s );
     return s;
 }
 
 std::string StringUtil::ToLower( std::string_view str ) {
     std::string s( str );
-    std::transform( s.begin(), s.end(), s.begin(), ::tolower );
+    ToLowerInPlace( s );
     return s;
 }
 
+void StringUtil::ToUpperInPlace( std::string &str ) noexcept {
+    ConvertCaseInPlace( str, 'a' );
+}
+
+void StringUtil::ToLowerInPlace( std::string &str ) noexcept {
+    ConvertCaseInPlace( str, 'A' );
+}
+
 bool StringUtil::StartWith( std::string_view str, std::string_view prefix ) {
     if ( str.size() < prefix.size() ) {
         return false;
@@ -483,29 +1912,346 @@ bool StringUtil::Contains( std::string_view str, std::string_view token ) noexce
     return str.find( token ) != std::string::npos ? true : false;
 }
 
+bool StringUtil::ContainsAny( std::string_view str, const NeedleSet &needles ) noexcept {
+    return FindAny( str, needles ).has_value();
+}
+
+std::optional<NeedleSet::Match> StringUtil::FindAny( std::string_view str, const NeedleSet &needles,
+                                                     size_t pos ) noexcept {
+    static const FindNeedlesFunc find_needles = SelectFindNeedles();
+    if ( pos > str.size() ) {
+        return std::nullopt;
+    }
+    if ( find_needles == nullptr || needles.packed_.empty() ) {
+        return needles.matcher_.FindNext( str, pos );
+    }
+
+    const std::string *packed = needles.packed_.data();
+    const size_t       count  = needles.packed_.size();
+    size_t             index  = std::string_view::npos;
+    if ( !find_needles( str.data(), str.size(), packed, count, needles.packed_max_length_, pos, index ) ) {
+        for ( ; pos < str.size(); ++pos ) {
+            index = MatchNeedlesAt( str.data(), str.size(), pos, packed, count );
+            if ( index != std::string_view::npos ) {
+                break;
+            }
+        }
+    }
+    if ( index == std::string_view::npos ) {
+        return std::nullopt;
+    }
+    return NeedleSet::Match{ needles.packed_ids_[index], pos, packed[index].size() };
+}
+
 std::string StringUtil::ConvertToHexStr( std::string_view data, char separator ) {
-    std::stringstream ss;
-    for ( size_t i = 0; i < data.length(); ++i ) {
-        // 每个字节转换为两位十六进制
-        ss << std::setw( 2 ) << std::setfill( '0' ) << std::hex << (int)(unsigned char)data[i];
-        // 在每两个字符之间添加间隔符
-        if ( i < data.length() - 1 ) {
-            ss << separator;
+    return HexEncode( data, std::string_view( &separator, 1 ) );
+}
+
+std::string StringUtil::HexEncode( std::string_view data, std::string_view separator, bool uppercase ) {
+    std::string result;
+    AppendHexEncoded( result, data, separator, uppercase );
+    return result;
+}
+
+void StringUtil::AppendHexEncoded( std::string &out, std::string_view data, std::string_view separator,
+                                   bool uppercase ) {
+    static constexpr char lower_digits[] = "0123456789abcdef";
+    static constexpr char upper_digits[] = "0123456789ABCDEF";
+    if ( data.empty() ) {
+        return;
+    }
+
+    const char  *digits = uppercase ? upper_digits : lower_digits;
+    const size_t start  = out.size();
+    out.resize( start + data.size() * 2 + ( data.size() - 1 ) * separator.size() );
+    char  *dst = out.data() + start;
+    size_t i   = 0;
+    if ( separator.empty() ) {
+        static const HexEncodeFunc encode = SelectHexEncode();
+        if ( encode ) {
+            i = encode( data.data(), data.size(), dst, digits );
+            dst += 2 * i;
+        }
+    }
+    for ( ; i < data.size(); ++i ) {
+        if ( i > 0 && !separator.empty() ) {
+            std::memcpy( dst, separator.data(), separator.size() );
+            dst += separator.size();
+        }
+        const auto c = static_cast<unsigned char>( data[i] );
+        dst[0]       = digits[c >> 4];
+        dst[1]       = digits[c & 0xF];
+        dst += 2;
+    }
+}
+
+std::optional<std::string> StringUtil::HexDecode( std::string_view hex, std::string_view separator ) {
+    std::string result;
+    if ( !AppendHexDecoded( result, hex, separator ) ) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+bool StringUtil::AppendHexDecoded( std::string &out, std::string_view hex, std::string_view separator ) {
+    if ( hex.empty() ) {
+        return true;
+    }
+    // n 个字节对应 2n + (n-1)*分隔符长度 个字符
+    const size_t stride = 2 + separator.size();
+    if ( ( hex.size() + separator.size() ) % stride != 0 ) {
+        return false;
+    }
+
+    const size_t count = ( hex.size() + separator.size() ) / stride;
+    const size_t start = out.size();
+    out.resize( start + count );
+    char  *dst = out.data() + start;
+    size_t i   = 0;
+    if ( separator.empty() ) {
+        static const HexDecodeFunc decode = SelectHexDecode();
+        if ( decode ) {
+            i = decode( hex.data(), count, dst );
+        }
+    }
+    for ( ; i < count; ++i ) {
+        const char *pair = hex.data() + i * stride;
+        const bool  separated =
+            i == 0 || separator.empty() ||
+            std::memcmp( pair - separator.size(), separator.data(), separator.size() ) == 0;
+        const int high = HexDigitValue( pair[0] );
+        const int low  = HexDigitValue( pair[1] );
+        if ( !separated || high < 0 || low < 0 ) {
+            out.resize( start );
+            return false;
+        }
+        dst[i] = static_cast<char>( ( high << 4 ) | low );
+    }
+    return true;
+}
+
+std::string StringUtil::Base64Encode( std::string_view data, Base64Alphabet alphabet, bool padding ) {
+    std::string result;
+    AppendBase64Encoded( result, data, alphabet, padding );
+    return result;
+}
+
+void StringUtil::AppendBase64Encoded( std::string &out, std::string_view data, Base64Alphabet alphabet,
+                                      bool padding ) {
+    static constexpr char standard_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static constexpr char url_safe_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    static const Base64EncodeFunc encode   = SelectBase64Encode();
+
+    const char  *chars     = alphabet == Base64Alphabet::kUrlSafe ? url_safe_chars : standard_chars;
+    const size_t remainder = data.size() % 3;
+    const size_t length    = data.size() / 3 * 4 + ( remainder == 0 ? 0 : ( padding ? 4 : remainder + 1 ) );
+    const size_t start     = out.size();
+    out.resize( start + length );
+
+    char  *dst = out.data() + start;
+    size_t i   = 0;
+    if ( encode ) {
+        i = encode( data.data(), data.size(), dst, Base64ExtraChars( alphabet ) );
+        dst += i / 3 * 4;
+    }
+    const auto *bytes = reinterpret_cast<const unsigned char *>( data.data() );
+    for ( ; i + 3 <= data.size(); i += 3 ) {
+        const uint32_t group = ( uint32_t( bytes[i] ) << 16 ) | ( uint32_t( bytes[i + 1] ) << 8 ) | bytes[i + 2];
+        dst[0]               = chars[group >> 18];
+        dst[1]               = chars[( group >> 12 ) & 0x3F];
+        dst[2]               = chars[( group >> 6 ) & 0x3F];
+        dst[3]               = chars[group & 0x3F];
+        dst += 4;
+    }
+    if ( remainder == 0 ) {
+        return;
+    }
+    const uint32_t group = ( uint32_t( bytes[i] ) << 16 ) | ( remainder == 2 ? uint32_t( bytes[i + 1] ) << 8 : 0 );
+    dst[0]               = chars[group >> 18];
+    dst[1]               = chars[( group >> 12 ) & 0x3F];
+    if ( remainder == 2 ) {
+        dst[2] = chars[( group >> 6 ) & 0x3F];
+    }
+    else if ( padding ) {
+        dst[2] = '=';
+    }
+    if ( padding ) {
+        dst[3] = '=';
+    }
+}
+
+std::optional<std::string> StringUtil::Base64Decode( std::string_view str, Base64Alphabet alphabet, bool strict ) {
+    std::string result;
+    if ( !AppendBase64Decoded( result, str, alphabet, strict ) ) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+bool StringUtil::AppendBase64Decoded( std::string &out, std::string_view str, Base64Alphabet alphabet,
+                                      bool strict ) {
+    static constexpr std::array<int8_t, 256> tables[] = {
+        MakeBase64DecodeTable( Base64Alphabet::kStandard, false ),
+        MakeBase64DecodeTable( Base64Alphabet::kUrlSafe, false ),
+        MakeBase64DecodeTable( Base64Alphabet::kStandard, true ),
+    };
+    static const Base64DecodeFunc decode = SelectBase64Decode();
+
+    const auto &table = strict ? tables[static_cast<size_t>( alphabet )] : tables[2];
+    size_t      end   = str.size();
+    if ( !strict ) {
+        while ( end > 0 && table[static_cast<unsigned char>( str[end - 1] )] == kBase64Space ) {
+            --end;
+        }
+    }
+    size_t padding = 0;
+    while ( end > 0 && str[end - 1] == '=' && padding < 2 ) {
+        --end;
+        ++padding;
+    }
+    if ( strict && padding > 0 && str.size() % 4 != 0 ) {
+        return false;
+    }
+
+    // 按上界分配，宽松模式下的空白只会使实际长度更短
+    const size_t start = out.size();
+    out.resize( start + end / 4 * 3 + 3 );
+    char    *dst     = out.data() + start;
+    size_t   written = 0;
+    uint32_t group   = 0;
+    size_t   count   = 0;  ///< group 中已累积的6位值个数
+    size_t   i       = 0;
+    while ( i < end ) {
+        if ( count == 0 && decode ) {
+            const size_t decoded = decode( str.data() + i, end - i, dst + written, Base64ExtraChars( alphabet ) );
+            i += decoded;
+            written += decoded / 4 * 3;
+            if ( i >= end ) {
+                break;
+            }
+        }
+        const int8_t value = table[static_cast<unsigned char>( str[i++] )];
+        if ( value < 0 ) {
+            if ( value == kBase64Space ) {
+                continue;
+            }
+            out.resize( start );
+            return false;
+        }
+        group = ( group << 6 ) | static_cast<uint32_t>( value );
+        if ( ++count == 4 ) {
+            dst[written]     = static_cast<char>( group >> 16 );
+            dst[written + 1] = static_cast<char>( group >> 8 );
+            dst[written + 2] = static_cast<char>( group );
+            written += 3;
+            group = 0;
+            count = 0;
         }
     }
-    return ss.str();
+
+    // 剩余2或3个字符分别对应1或2个字节；严格模式要求填充完整且多余比特为0
+    bool ok = count != 1;
+    if ( count == 2 ) {
+        dst[written++] = static_cast<char>( group >> 4 );
+        ok             = !strict || ( ( group & 0xF ) == 0 && ( padding == 0 || padding == 2 ) );
+    }
+    else if ( count == 3 ) {
+        dst[written++] = static_cast<char>( group >> 10 );
+        dst[written++] = static_cast<char>( group >> 2 );
+        ok             = !strict || ( ( group & 0x3 ) == 0 && ( padding == 0 || padding == 1 ) );
+    }
+    else if ( count == 0 ) {
+        ok = !strict || padding == 0;
+    }
+    out.resize( ok ? start + written : start );
+    return ok;
 }
 
 bool StringUtil::EqualsIgnoreCase( std::string_view str1, std::string_view str2 ) noexcept {
+    static const MismatchIgnoreCaseFunc mismatch = SelectMismatchIgnoreCase();
     if ( str1.size() != str2.size() ) {
         return false;
     }
-    for ( size_t i = 0; i < str1.size(); ++i ) {
-        if ( std::tolower( str1[i] ) != std::tolower( str2[i] ) ) {
+    size_t i = mismatch ? mismatch( str1.data(), str2.data(), str1.size() ) : 0;
+    for ( ; i < str1.size(); ++i ) {
+        if ( AsciiToLower( str1[i] ) != AsciiToLower( str2[i] ) ) {
             return false;
         }
     }
-    return true;
+    return true;
+}
+
+size_t StringUtil::FindIgnoreCase( std::string_view str, std::string_view token, size_t pos ) noexcept {
+    static const FindIgnoreCaseFunc find = SelectFindIgnoreCase();
+    if ( pos > str.size() || token.size() > str.size() - pos ) {
+        return std::string_view::npos;
+    }
+    if ( token.empty() ) {
+        return pos;
+    }
+    if ( find && find( str, token, pos ) ) {
+        return pos;
+    }
+
+    const char first = AsciiToLower( token.front() );
+    for ( ; pos + token.size() <= str.size(); ++pos ) {
+        if ( AsciiToLower( str[pos] ) == first &&
+             EqualsIgnoreCase( str.substr( pos + 1, token.size() - 1 ), token.substr( 1 ) ) ) {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+bool StringUtil::ContainsIgnoreCase( std::string_view str, std::string_view token ) noexcept {
+    return FindIgnoreCase( str, token ) != std::string_view::npos;
+}
+
+bool StringUtil::StartWithIgnoreCase( std::string_view str, std::string_view prefix ) noexcept {
+    return str.size() >= prefix.size() && EqualsIgnoreCase( str.substr( 0, prefix.size() ), prefix );
+}
+
+bool StringUtil::EndWithIgnoreCase( std::string_view str, std::string_view suffix ) noexcept {
+    return str.size() >= suffix.size() && EqualsIgnoreCase( str.substr( str.size() - suffix.size() ), suffix );
+}
+
+const char *StringUtil::ParseDecimalDigits( const char *begin, const char *end, uint64_t &value,
+                                            bool &overflow ) noexcept {
+    constexpr uint64_t kMax = std::numeric_limits<uint64_t>::max();
+
+    const char *p      = begin;
+    uint64_t    result = 0;
+    overflow           = false;
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while ( end - p >= 8 ) {
+        uint64_t chunk;
+        std::memcpy( &chunk, p, 8 );
+        // 每个字节的高半字节为3，且低半字节加6后不进位，即全部为 '0'..'9'
+        if ( ( chunk & 0xF0F0F0F0F0F0F0F0ULL ) != 0x3030303030303030ULL ||
+             ( ( chunk + 0x0606060606060606ULL ) & 0xF0F0F0F0F0F0F0F0ULL ) != 0x3030303030303030ULL ) {
+            break;
+        }
+        // 相邻数字两两合并，再合并为4位、8位
+        chunk -= 0x3030303030303030ULL;
+        chunk = ( chunk * 10 + ( chunk >> 8 ) ) & 0x00FF00FF00FF00FFULL;
+        chunk = ( chunk * 100 + ( chunk >> 16 ) ) & 0x0000FFFF0000FFFFULL;
+        chunk = ( chunk * 10000 + ( chunk >> 32 ) ) & 0x00000000FFFFFFFFULL;
+        if ( result > ( kMax - chunk ) / 100000000 ) {
+            overflow = true;
+        }
+        result = result * 100000000 + chunk;
+        p += 8;
+    }
+#endif
+    for ( ; p < end && static_cast<unsigned char>( *p - '0' ) < 10; ++p ) {
+        const auto digit = static_cast<uint64_t>( *p - '0' );
+        if ( result > ( kMax - digit ) / 10 ) {
+            overflow = true;
+        }
+        result = result * 10 + digit;
+    }
+    value = result;
+    return p;
 }
 
 std::string StringUtil::IntToBitString( uint64_t value, int count ) noexcept {
@@ -548,17 +2294,201 @@ std::optional<std::string_view> StringUtil::ExtractBetween( std::string_view str
     return str.substr( content_start, content_end - content_start );
 }
 
+class CompiledRegex::Impl {
+public:
+    Impl( std::string_view pattern, RegexEngine engine ) : pattern( pattern ), engine( engine ) {}
+
+    std::string                  pattern;
+    RegexEngine                  engine;
+    std::regex                   regex;   ///< engine == kStd 时有效
+    std::unique_ptr<LinearRegex> linear;  ///< engine == kLinear 时有效
+};
+
+CompiledRegex CompiledRegex::Compile( std::string_view pattern, std::string *error_msg, RegexEngine engine ) {
+    CompiledRegex compiled;
+    auto          impl = std::make_shared<Impl>( pattern, engine );
+    if ( engine == RegexEngine::kLinear ) {
+        impl->linear = LinearRegex::Compile( pattern, error_msg );
+        if ( !impl->linear ) {
+            return compiled;
+        }
+    }
+    else {
+        try {
+            impl->regex = std::regex( impl->pattern );
+        }
+        catch ( const std::regex_error &e ) {
+            if ( error_msg ) {
+                *error_msg = e.what();
+            }
+            return compiled;
+        }
+    }
+    compiled.impl_ = std::move( impl );
+    return compiled;
+}
+
+std::string_view CompiledRegex::Pattern() const noexcept {
+    return impl_ ? std::string_view( impl_->pattern ) : std::string_view{};
+}
+
+RegexEngine CompiledRegex::Engine() const noexcept {
+    return impl_ ? impl_->engine : RegexEngine::kStd;
+}
+
+const LinearRegex *CompiledRegex::Linear() const noexcept {
+    return impl_ ? impl_->linear.get() : nullptr;
+}
+
+namespace {
+
+std::atomic<RegexEngine> g_regex_engine{ RegexEngine::kStd };
+
+/// 线程安全的LRU正则缓存，以引擎和模式字符串为键
+class RegexCache {
+public:
+    static RegexCache &Instance() {
+        static RegexCache cache;
+        return cache;
+    }
+
+    CompiledRegex Get( std::string_view pattern, std::string *error_msg ) {
+        const RegexEngine engine = g_regex_engine.load( std::memory_order_relaxed );
+        std::string       key    = MakeKey( pattern, engine );
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            auto                        iter = index_.find( key );
+            if ( iter != index_.end() ) {
+                lru_.splice( lru_.begin(), lru_, iter->second );
+                return iter->second->second;
+            }
+        }
+
+        // 编译耗时较长，不持有锁
+        CompiledRegex compiled = CompiledRegex::Compile( pattern, error_msg, engine );
+        if ( !compiled.Valid() ) {
+            return compiled;
+        }
+
+        std::lock_guard<std::mutex> lock( mutex_ );
+        if ( capacity_ == 0 || index_.count( key ) != 0 ) {
+            return compiled;
+        }
+        lru_.emplace_front( std::move( key ), compiled );
+        index_.emplace( lru_.front().first, lru_.begin() );
+        Evict();
+        return compiled;
+    }
+
+    void SetCapacity( size_t capacity ) {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        capacity_ = capacity;
+        Evict();
+    }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        index_.clear();
+        lru_.clear();
+    }
+
+private:
+    using Entry = std::pair<std::string, CompiledRegex>;
+
+    static std::string MakeKey( std::string_view pattern, RegexEngine engine ) {
+        std::string key;
+        key.reserve( pattern.size() + 1 );
+        key.push_back( static_cast<char>( engine ) );
+        key.append( pattern );
+        return key;
+    }
+
+    void Evict() {
+        while ( lru_.size() > capacity_ ) {
+            index_.erase( lru_.back().first );
+            lru_.pop_back();
+        }
+    }
+
+    std::mutex                                                       mutex_;
+    size_t                                                           capacity_ = 128;
+    std::list<Entry>                                                 lru_;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;  ///< 键引用lru_中的键字符串
+};
+
+/// 依次回调 LinearRegex 的所有不重叠匹配；空匹配之后先在原位置重试非空匹配，与 std::regex_iterator 一致
+template <typename Func>
+void ForEachLinearMatch( const LinearRegex &regex, std::string_view text, Func &&on_match ) {
+    std::vector<LinearRegex::Span> groups;
+    size_t                         pos       = 0;
+    bool                           not_empty = false;
+    while ( pos <= text.size() && regex.Search( text, pos, groups, not_empty ) ) {
+        on_match( groups );
+        pos       = groups[0].end;
+        not_empty = groups[0].end == groups[0].begin;
+    }
+}
+
+std::string SpanToString( std::string_view text, const LinearRegex::Span &span ) {
+    if ( !span.Matched() ) {
+        return {};
+    }
+    return std::string( text.substr( span.begin, span.end - span.begin ) );
+}
+
+}  // namespace
+
+void StringUtil::SetRegexCacheCapacity( size_t capacity ) {
+    RegexCache::Instance().SetCapacity( capacity );
+}
+
+void StringUtil::ClearRegexCache() {
+    RegexCache::Instance().Clear();
+}
+
+void StringUtil::SetRegexEngine( RegexEngine engine ) {
+    g_regex_engine.store( engine, std::memory_order_relaxed );
+}
+
+RegexEngine StringUtil::GetRegexEngine() {
+    return g_regex_engine.load( std::memory_order_relaxed );
+}
+
 std::optional<std::string> StringUtil::ExtractFirst( std::string_view text, std::string_view pattern,
                                                      std::string *error_msg ) {
     ClearError( error_msg );
 
+    std::string   compile_error;
+    CompiledRegex regex = RegexCache::Instance().Get( pattern, &compile_error );
+    if ( !regex.Valid() ) {
+        SetError( error_msg, "Regex error in ExtractFirst: ", compile_error );
+        return std::nullopt;
+    }
+    return ExtractFirst( text, regex, error_msg );
+}
+
+std::optional<std::string> StringUtil::ExtractFirst( std::string_view text, const CompiledRegex &regex,
+                                                     std::string *error_msg ) {
+    ClearError( error_msg );
+    if ( !regex.Valid() ) {
+        SetError( error_msg, "Invalid regex in ExtractFirst." );
+        return std::nullopt;
+    }
+
+    if ( regex.impl_->linear ) {
+        std::vector<LinearRegex::Span> groups;
+        if ( regex.impl_->linear->Search( text, 0, groups ) ) {
+            return SpanToString( text, groups[0] );
+        }
+        return std::nullopt;
+    }
+
     try {
-        std::regex  re( pattern.begin(), pattern.end() );
         std::cmatch match;  // 注意：使用 cmatch 而不是 smatch
 
         if ( std::regex_search( text.data(),                // const char*
                                 text.data() + text.size(),  // end pointer
-                                match, re ) ) {
+                                match, regex.impl_->regex ) ) {
             return std::string( match[0].first, match.length( 0 ) );  // 手动构造 string
         }
         return std::nullopt;
@@ -577,11 +2507,41 @@ std::optional<std::string> StringUtil::ExtractGroup( std::string_view text, std:
                                                      size_t group_index, std::string *error_msg ) {
     ClearError( error_msg );
 
+    std::string   compile_error;
+    CompiledRegex regex = RegexCache::Instance().Get( pattern, &compile_error );
+    if ( !regex.Valid() ) {
+        SetError( error_msg, "Regex error in ExtractGroup: ", compile_error );
+        return std::nullopt;
+    }
+    return ExtractGroup( text, regex, group_index, error_msg );
+}
+
+std::optional<std::string> StringUtil::ExtractGroup( std::string_view text, const CompiledRegex &regex,
+                                                     size_t group_index, std::string *error_msg ) {
+    ClearError( error_msg );
+    if ( !regex.Valid() ) {
+        SetError( error_msg, "Invalid regex in ExtractGroup." );
+        return std::nullopt;
+    }
+
+    if ( regex.impl_->linear ) {
+        const LinearRegex             &linear = *regex.impl_->linear;
+        std::vector<LinearRegex::Span> groups;
+        if ( !linear.Search( text, 0, groups ) ) {
+            return std::nullopt;
+        }
+        if ( group_index < linear.GroupCount() ) {
+            return SpanToString( text, groups[group_index] );
+        }
+        SetError( error_msg, "Capture group index out of range: ", std::to_string( group_index ),
+                  " (max available: ", std::to_string( linear.GroupCount() - 1 ), ")" );
+        return std::nullopt;
+    }
+
     try {
-        std::regex  re( pattern.begin(), pattern.end() );
         std::cmatch match;
 
-        if ( std::regex_search( text.data(), text.data() + text.size(), match, re ) ) {
+        if ( std::regex_search( text.data(), text.data() + text.size(), match, regex.impl_->regex ) ) {
             if ( group_index < match.size() ) {
                 auto &sub = match[group_index];
                 return std::string( sub.first, sub.length() );
@@ -604,13 +2564,36 @@ std::optional<std::string> StringUtil::ExtractGroup( std::string_view text, std:
 
 std::vector<std::string> StringUtil::ExtractAll( std::string_view text, std::string_view pattern,
                                                  std::string *error_msg ) {
+    ClearError( error_msg );
+
+    std::string   compile_error;
+    CompiledRegex regex = RegexCache::Instance().Get( pattern, &compile_error );
+    if ( !regex.Valid() ) {
+        SetError( error_msg, "Regex error in ExtractAll: ", compile_error );
+        return {};
+    }
+    return ExtractAll( text, regex, error_msg );
+}
+
+std::vector<std::string> StringUtil::ExtractAll( std::string_view text, const CompiledRegex &regex,
+                                                 std::string *error_msg ) {
     std::vector<std::string> results;
     ClearError( error_msg );
+    if ( !regex.Valid() ) {
+        SetError( error_msg, "Invalid regex in ExtractAll." );
+        return results;
+    }
 
-    try {
-        std::regex re( pattern.begin(), pattern.end() );
+    if ( regex.impl_->linear ) {
+        ForEachLinearMatch( *regex.impl_->linear, text, [&]( const std::vector<LinearRegex::Span> &groups ) {
+            results.push_back( SpanToString( text, groups[0] ) );
+        } );
+        return results;
+    }
 
+    try {
         // 使用 std::cregex_iterator（基于指针）
+        const std::regex    &re   = regex.impl_->regex;
         auto                 iter = std::cregex_iterator( text.data(), text.data() + text.size(), re );
         std::cregex_iterator end;
 
@@ -631,11 +2614,45 @@ std::vector<std::string> StringUtil::ExtractAll( std::string_view text, std::str
 
 std::vector<std::string> StringUtil::ExtractAllGroups( std::string_view text, std::string_view pattern,
                                                        size_t group_index, std::string *error_msg ) {
+    ClearError( error_msg );
+
+    std::string   compile_error;
+    CompiledRegex regex = RegexCache::Instance().Get( pattern, &compile_error );
+    if ( !regex.Valid() ) {
+        SetError( error_msg, "Regex error in ExtractAllGroups: ", compile_error );
+        return {};
+    }
+    return ExtractAllGroups( text, regex, group_index, error_msg );
+}
+
+std::vector<std::string> StringUtil::ExtractAllGroups( std::string_view text, const CompiledRegex &regex,
+                                                       size_t group_index, std::string *error_msg ) {
     std::vector<std::string> results;
     ClearError( error_msg );
+    if ( !regex.Valid() ) {
+        SetError( error_msg, "Invalid regex in ExtractAllGroups." );
+        return results;
+    }
+
+    if ( regex.impl_->linear ) {
+        const LinearRegex &linear = *regex.impl_->linear;
+        if ( group_index >= linear.GroupCount() ) {
+            // 与 std::regex 路径一致：只要存在匹配就提示捕获组缺失
+            std::vector<LinearRegex::Span> groups;
+            if ( linear.Search( text, 0, groups ) ) {
+                SetError( error_msg, "Some capture groups at index ", std::to_string( group_index ),
+                          " were missing." );
+            }
+            return results;
+        }
+        ForEachLinearMatch( linear, text, [&]( const std::vector<LinearRegex::Span> &groups ) {
+            results.push_back( SpanToString( text, groups[group_index] ) );
+        } );
+        return results;
+    }
 
     try {
-        std::regex           re( pattern.begin(), pattern.end() );
+        const std::regex    &re   = regex.impl_->regex;
         auto                 iter = std::cregex_iterator( text.data(), text.data() + text.size(), re );
         std::cregex_iterator end;
 
@@ -684,24 +2701,212 @@ std::string StringUtil::PadRight( std::string_view str, size_t width, char fill_
     return result;
 }
 
+namespace {
+
+/// xoshiro256** 伪随机数发生器，每线程一个实例，从 random_device 取种子
+class FastRandom {
+public:
+    static FastRandom &ThreadLocal() noexcept {
+        thread_local FastRandom random;
+        return random;
+    }
+
+    uint64_t Next() noexcept {
+        const uint64_t result = Rotl( state_[1] * 5, 7 ) * 9;
+        const uint64_t t      = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = Rotl( state_[3], 45 );
+        return result;
+    }
+
+    /// 返回 [0, bound) 内的均匀随机数
+    uint64_t Below( uint64_t bound ) noexcept {
+        const uint64_t threshold = ( 0 - bound ) % bound;  // 2^64 mod bound，小于该值的结果会带来偏差
+        uint64_t       r;
+        do {
+            r = Next();
+        } while ( r < threshold );
+        return r % bound;
+    }
+
+private:
+    FastRandom() noexcept {
+        uint64_t seed = 0;
+        try {
+            std::random_device rd;
+            seed = ( static_cast<uint64_t>( rd() ) << 32 ) ^ rd();
+        }
+        catch ( ... ) {
+        }
+        // 混入线程私有地址和时间，random_device 不可用时也能区分各线程
+        seed ^= reinterpret_cast<uintptr_t>( this );
+        seed ^= static_cast<uint64_t>( std::chrono::steady_clock::now().time_since_epoch().count() );
+        for ( auto &state : state_ ) {
+            state = SplitMix64( seed );
+        }
+    }
+
+    static uint64_t Rotl( uint64_t x, int k ) noexcept { return ( x << k ) | ( x >> ( 64 - k ) ); }
+    static uint64_t SplitMix64( uint64_t &x ) noexcept {
+        uint64_t z = ( x += 0x9E3779B97F4A7C15ULL );
+        z          = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+        z          = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+        return z ^ ( z >> 31 );
+    }
+
+    uint64_t state_[4];
+};
+
+constexpr char kLowerHexDigits[] = "0123456789abcdef";
+
+/// 按 8-4-4-4-12 格式写出16字节UUID，dest 至少 kUuidLength 字节
+void FormatUuid( const uint8_t ( &bytes )[16], char *dest ) noexcept {
+    for ( size_t i = 0; i < 16; ++i ) {
+        if ( i == 4 || i == 6 || i == 8 || i == 10 ) {
+            *dest++ = '-';
+        }
+        *dest++ = kLowerHexDigits[bytes[i] >> 4];
+        *dest++ = kLowerHexDigits[bytes[i] & 0x0F];
+    }
+}
+
+void StoreBigEndian( uint8_t *dest, uint64_t value ) noexcept {
+    for ( int i = 7; i >= 0; --i ) {
+        dest[i] = static_cast<uint8_t>( value );
+        value >>= 8;
+    }
+}
+
+}  // namespace
+
 std::string StringUtil::RandomString( size_t length, std::string_view charset ) noexcept {
     if ( charset.empty() || length == 0 ) {
         return {};
     }
+    std::string result;
+    try {
+        result.resize( length );
+    }
+    catch ( ... ) {
+        return {};
+    }
+    RandomStringTo( result.data(), result.data() + length, charset );
+    return result;
+}
 
-    thread_local static std::random_device rd;
-    thread_local static std::seed_seq      seed{ rd(), rd(), rd(), rd() };
-    thread_local static std::mt19937       gen( seed );
-    std::uniform_int_distribution<size_t>  dis( 0, charset.length() - 1 );
+char *StringUtil::RandomStringTo( char *first, char *last, std::string_view charset ) noexcept {
+    if ( charset.empty() || first >= last ) {
+        return first;
+    }
+    FastRandom  &random = FastRandom::ThreadLocal();
+    const size_t n      = charset.size();
 
-    std::string result;
-    result.reserve( length );
+    if ( ( n & ( n - 1 ) ) == 0 ) {
+        // 字符集大小为2的幂：按位掩码截取，每次64位抽样产出 64/bits 个字符
+        int bits = 1;
+        while ( ( size_t{ 1 } << bits ) < n ) {
+            ++bits;
+        }
+        const int      per_draw = 64 / bits;
+        const uint64_t mask     = n - 1;
+        while ( first < last ) {
+            uint64_t r     = random.Next();
+            const int take = static_cast<int>( std::min<ptrdiff_t>( per_draw, last - first ) );
+            for ( int i = 0; i < take; ++i ) {
+                *first++ = charset[r & mask];
+                r >>= bits;
+            }
+        }
+    }
+    else if ( n <= 256 ) {
+        // 每次抽样拆成8个字节，按 Lemire 乘法映射到 [0, n)，拒绝低位落入 256 % n 的字节以保持均匀，避免逐字符除法
+        const unsigned reject = static_cast<unsigned>( 256 % n );
+        while ( first < last ) {
+            uint64_t r = random.Next();
+            for ( int i = 0; i < 8 && first < last; ++i, r >>= 8 ) {
+                const unsigned m = static_cast<unsigned>( r & 0xFF ) * static_cast<unsigned>( n );
+                if ( ( m & 0xFF ) >= reject ) {
+                    *first++ = charset[m >> 8];
+                }
+            }
+        }
+    }
+    else {
+        while ( first < last ) {
+            *first++ = charset[random.Below( n )];
+        }
+    }
+    return last;
+}
 
-    for ( size_t i = 0; i < length; ++i ) {
-        result += charset[dis( gen )];
+std::string StringUtil::UuidV4() noexcept {
+    char buffer[kUuidLength];
+    UuidV4To( buffer, buffer + sizeof( buffer ) );
+    try {
+        return std::string( buffer, sizeof( buffer ) );
+    }
+    catch ( ... ) {
+        return {};
     }
+}
 
-    return result;
+char *StringUtil::UuidV4To( char *first, char *last ) noexcept {
+    if ( last - first < static_cast<ptrdiff_t>( kUuidLength ) ) {
+        return nullptr;
+    }
+    FastRandom &random = FastRandom::ThreadLocal();
+    uint8_t     bytes[16];
+    StoreBigEndian( bytes, random.Next() );
+    StoreBigEndian( bytes + 8, random.Next() );
+    bytes[6] = static_cast<uint8_t>( ( bytes[6] & 0x0F ) | 0x40 );  // 版本 4
+    bytes[8] = static_cast<uint8_t>( ( bytes[8] & 0x3F ) | 0x80 );  // RFC 9562 变体
+    FormatUuid( bytes, first );
+    return first + kUuidLength;
+}
+
+std::string StringUtil::UuidV7() noexcept {
+    char buffer[kUuidLength];
+    UuidV7To( buffer, buffer + sizeof( buffer ) );
+    try {
+        return std::string( buffer, sizeof( buffer ) );
+    }
+    catch ( ... ) {
+        return {};
+    }
+}
+
+char *StringUtil::UuidV7To( char *first, char *last ) noexcept {
+    if ( last - first < static_cast<ptrdiff_t>( kUuidLength ) ) {
+        return nullptr;
+    }
+    // 同一毫秒内以 rand_a 的12位作为计数器（RFC 9562 方法3），保证同一线程生成的ID严格递增；
+    // 计数器溢出或时钟回拨时沿用上一个时间戳并向前借位
+    thread_local uint64_t last_ms = 0;
+    thread_local uint32_t counter = 0;
+
+    FastRandom    &random = FastRandom::ThreadLocal();
+    const uint64_t now    = static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                    std::chrono::system_clock::now().time_since_epoch() )
+                                                    .count() );
+    if ( now > last_ms ) {
+        last_ms = now;
+        counter = static_cast<uint32_t>( random.Next() >> 53 );  // 11位随机起点，为同一毫秒内的递增留出空间
+    }
+    else if ( ++counter > 0xFFF ) {
+        ++last_ms;
+        counter = 0;
+    }
+
+    uint8_t bytes[16];
+    StoreBigEndian( bytes, ( last_ms << 16 ) | 0x7000 | counter );  // 48位时间戳 + 版本 7 + 12位计数器
+    StoreBigEndian( bytes + 8, random.Next() );
+    bytes[8] = static_cast<uint8_t>( ( bytes[8] & 0x3F ) | 0x80 );
+    FormatUuid( bytes, first );
+    return first + kUuidLength;
 }
 
 bool StringUtil::IsNumeric( std::string_view str ) noexcept {
@@ -715,43 +2920,30 @@ bool StringUtil::IsNumeric( std::string_view str ) noexcept {
         }
         start = 1;
     }
-    bool has_decimal_point = false;
-    for ( size_t i = start; i < str.size(); ++i ) {
-        if ( str[i] == '.' ) {
-            if ( has_decimal_point ) {
-                return false;  // 多个小数点为非法数字
-            }
-            has_decimal_point = true;
-        }
-        else if ( !std::isdigit( str[i] ) ) {
-            return false;  // 存在非数字字符
-        }
+    static const CharSet digit_or_point( "0123456789." );
+    const std::string_view body           = str.substr( start );
+    if ( !digit_or_point.AllOf( body ) ) {
+        return false;  // 存在非数字字符
     }
-    return true;
+    const size_t point = body.find( '.' );
+    // 多个小数点为非法数字
+    return point == std::string_view::npos || body.find( '.', point + 1 ) == std::string_view::npos;
 }
 
 bool StringUtil::IsUpper( std::string_view str ) noexcept {
     if ( str.empty() ) {
         return false;
     }
-    for ( auto c : str ) {
-        if ( !std::isupper( c ) ) {
-            return false;
-        }
-    }
-    return true;
+    static const CharSet upper = CharSet::Range( 'A', 'Z' );
+    return upper.AllOf( str );
 }
 
 bool StringUtil::IsLower( std::string_view str ) noexcept {
     if ( str.empty() ) {
         return false;
     }
-    for ( auto c : str ) {
-        if ( !std::islower( c ) ) {
-            return false;
-        }
-    }
-    return true;
+    static const CharSet lower = CharSet::Range( 'a', 'z' );
+    return lower.AllOf( str );
 }
 
 std::string StringUtil::CamelToSnake( std::string_view str ) noexcept {
@@ -828,4 +3020,372 @@ std::string StringUtil::SnakeToCamel( std::string_view str, bool upper_first ) n
     return result;
 }
 
+StringFormatter::Template StringFormatter::Compile( std::string_view format ) {
+    // 序号超过9位时不可能有对应的参数，按普通文本处理
+    constexpr size_t kMaxIndexDigits = 9;
+
+    Template result;
+    result.format_       = format;
+    size_t literal_begin = 0;
+    size_t pos           = 0;
+    while ( ( pos = format.find( '%', pos ) ) != std::string_view::npos ) {
+        size_t digits_end = pos + 1;
+        while ( digits_end < format.size() && static_cast<unsigned char>( format[digits_end] - '0' ) < 10 ) {
+            ++digits_end;
+        }
+        const size_t digits = digits_end - pos - 1;
+        if ( digits == 0 || format[pos + 1] == '0' || digits > kMaxIndexDigits ) {
+            pos = std::max( digits_end, pos + 1 );
+            continue;
+        }
+
+        size_t index = 0;
+        for ( size_t i = pos + 1; i < digits_end; ++i ) {
+            index = index * 10 + static_cast<size_t>( format[i] - '0' );
+        }
+        result.pieces_.push_back( { literal_begin, pos - literal_begin, index, digits + 1 } );
+        result.max_arg_index_ = std::max( result.max_arg_index_, index );
+        literal_begin = pos = digits_end;
+    }
+    result.pieces_.push_back( { literal_begin, format.size() - literal_begin, 0, 0 } );
+    return result;
+}
+
+void StringFormatter::Template::Append( std::string &out, const ArgText *args, size_t arg_count ) const {
+    size_t length = 0;
+    for ( const Piece &piece : pieces_ ) {
+        length += piece.literal_length;
+        if ( piece.arg_index == 0 ) {
+            continue;
+        }
+        length += piece.arg_index <= arg_count ? args[piece.arg_index - 1].View().size() : piece.placeholder_length;
+    }
+
+    const size_t start = out.size();
+    out.resize( start + length );
+    char *dst = out.data() + start;
+    for ( const Piece &piece : pieces_ ) {
+        std::memcpy( dst, format_.data() + piece.literal_begin, piece.literal_length );
+        dst += piece.literal_length;
+        if ( piece.arg_index == 0 ) {
+            continue;
+        }
+        // 缺少参数时保留占位符
+        const std::string_view text =
+            piece.arg_index <= arg_count
+                ? args[piece.arg_index - 1].View()
+                : std::string_view( format_ ).substr( piece.literal_begin + piece.literal_length,
+                                                      piece.placeholder_length );
+        if ( !text.empty() ) {
+            std::memcpy( dst, text.data(), text.size() );
+            dst += text.size();
+        }
+    }
+}
+
+namespace {
+
+// wyhash（v4.2，公有领域）的默认参数
+constexpr uint64_t kWyp0 = 0x2d358dccaa6c78a5ULL;
+constexpr uint64_t kWyp1 = 0x8bb84b93962eacc9ULL;
+constexpr uint64_t kWyp2 = 0x4b33a62ed433d4a3ULL;
+constexpr uint64_t kWyp3 = 0x4d5a2da51de1aa47ULL;
+
+/// 64x64→128 位乘法，低64位写回 a，高64位写回 b
+inline void WyMum( uint64_t &a, uint64_t &b ) noexcept {
+#if defined( __SIZEOF_INT128__ )
+    const __uint128_t r = static_cast<__uint128_t>( a ) * b;
+    a                   = static_cast<uint64_t>( r );
+    b                   = static_cast<uint64_t>( r >> 64 );
+#else
+    const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>( a ), lb = static_cast<uint32_t>( b );
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t  = rl + ( rm0 << 32 );
+    uint64_t       hi = rh + ( rm0 >> 32 ) + ( rm1 >> 32 ) + ( t < rl );
+    const uint64_t lo = t + ( rm1 << 32 );
+    hi += lo < t;
+    a = lo;
+    b = hi;
+#endif
+}
+
+inline uint64_t WyMix( uint64_t a, uint64_t b ) noexcept {
+    WyMum( a, b );
+    return a ^ b;
+}
+
+/// 把每个字节中的ASCII大写字母转为小写（SWAR，一次处理8字节）
+inline uint64_t FoldAsciiLower( uint64_t x ) noexcept {
+    constexpr uint64_t kOnes   = 0x0101010101010101ULL;
+    const uint64_t     heptets = x & ( 0x7F * kOnes );
+    const uint64_t     ge_a    = heptets + ( 0x80 - 'A' ) * kOnes;  // 最高位为1表示 >= 'A'
+    const uint64_t     gt_z    = heptets + ( 0x7F - 'Z' ) * kOnes;  // 最高位为1表示 > 'Z'
+    const uint64_t     upper   = ( ge_a ^ gt_z ) & ~x & ( 0x80 * kOnes );
+    return x | ( upper >> 2 );
+}
+
+template <bool kFoldCase>
+struct WyReader {
+    static uint64_t Read8( const uint8_t *p ) noexcept {
+        uint64_t v;
+        std::memcpy( &v, p, sizeof( v ) );
+        return kFoldCase ? FoldAsciiLower( v ) : v;
+    }
+    static uint64_t Read4( const uint8_t *p ) noexcept {
+        uint32_t v;
+        std::memcpy( &v, p, sizeof( v ) );
+        return kFoldCase ? FoldAsciiLower( v ) : v;
+    }
+    static uint64_t Read3( const uint8_t *p, size_t k ) noexcept {
+        return ( Byte( p[0] ) << 16 ) | ( Byte( p[k >> 1] ) << 8 ) | Byte( p[k - 1] );
+    }
+    static uint64_t Byte( uint8_t c ) noexcept {
+        return kFoldCase ? static_cast<uint8_t>( AsciiToLower( static_cast<char>( c ) ) ) : c;
+    }
+};
+
+template <bool kFoldCase>
+uint64_t WyHash( std::string_view str, uint64_t seed ) noexcept {
+    using Reader       = WyReader<kFoldCase>;
+    const uint8_t *p   = reinterpret_cast<const uint8_t *>( str.data() );
+    const size_t   len = str.size();
+    uint64_t       a   = 0;
+    uint64_t       b   = 0;
+
+    seed ^= WyMix( seed ^ kWyp0, kWyp1 );
+    if ( len <= 16 ) {
+        if ( len >= 4 ) {
+            a = ( Reader::Read4( p ) << 32 ) | Reader::Read4( p + ( ( len >> 3 ) << 2 ) );
+            b = ( Reader::Read4( p + len - 4 ) << 32 ) | Reader::Read4( p + len - 4 - ( ( len >> 3 ) << 2 ) );
+        }
+        else if ( len > 0 ) {
+            a = Reader::Read3( p, len );
+        }
+    }
+    else {
+        size_t i = len;
+        if ( i >= 48 ) {
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+            do {
+                seed = WyMix( Reader::Read8( p ) ^ kWyp1, Reader::Read8( p + 8 ) ^ seed );
+                see1 = WyMix( Reader::Read8( p + 16 ) ^ kWyp2, Reader::Read8( p + 24 ) ^ see1 );
+                see2 = WyMix( Reader::Read8( p + 32 ) ^ kWyp3, Reader::Read8( p + 40 ) ^ see2 );
+                p += 48;
+                i -= 48;
+            } while ( i >= 48 );
+            seed ^= see1 ^ see2;
+        }
+        while ( i > 16 ) {
+            seed = WyMix( Reader::Read8( p ) ^ kWyp1, Reader::Read8( p + 8 ) ^ seed );
+            i -= 16;
+            p += 16;
+        }
+        a = Reader::Read8( p + i - 16 );
+        b = Reader::Read8( p + i - 8 );
+    }
+    a ^= kWyp1;
+    b ^= seed;
+    WyMum( a, b );
+    return WyMix( a ^ kWyp0 ^ len, b ^ kWyp1 );
+}
+
+}  // namespace
+
+uint64_t StringUtil::Hash( std::string_view str, uint64_t seed ) noexcept {
+    return WyHash<false>( str, seed );
+}
+
+uint64_t StringUtil::HashIgnoreCase( std::string_view str, uint64_t seed ) noexcept {
+    return WyHash<true>( str, seed );
+}
+
+namespace {
+
+/**
+ * Myers 位并行编辑距离（Hyyrö 的 Levenshtein 形式）：模式串按64字节分块，
+ * 每块保存垂直差分 Pv/Mv（该列相邻两行的差为 +1/-1），逐个处理文本字节并在块间传递水平差分。
+ */
+class MyersPattern {
+public:
+    explicit MyersPattern( std::string_view pattern )
+        : length_( pattern.size() ), blocks_( ( pattern.size() + 63 ) / 64 ) {
+        if ( blocks_ > 1 ) {
+            multi_peq_.assign( 256 * blocks_, 0 );
+            pv_.resize( blocks_ );
+            mv_.resize( blocks_ );
+        }
+        for ( size_t i = 0; i < pattern.size(); ++i ) {
+            const auto c = static_cast<unsigned char>( pattern[i] );
+            if ( blocks_ == 1 ) {
+                single_peq_[c] |= uint64_t{ 1 } << i;
+            }
+            else {
+                multi_peq_[c * blocks_ + i / 64] |= uint64_t{ 1 } << ( i % 64 );
+            }
+        }
+    }
+
+    /// 返回与 text 的编辑距离；超过 max_distance 时返回 npos
+    size_t Distance( std::string_view text, size_t max_distance ) const {
+        const size_t n    = text.size();
+        const size_t diff = n > length_ ? n - length_ : length_ - n;
+        if ( diff > max_distance ) {
+            return std::string_view::npos;
+        }
+        if ( length_ == 0 ) {
+            return n;
+        }
+        return blocks_ == 1 ? DistanceSingle( text, max_distance ) : DistanceMulti( text, max_distance );
+    }
+
+private:
+    /// 第 j 列处理完后最后一行的值为 score，此后每列最多减 1，据此判断是否已不可能回到阈值以内
+    static bool Exceeded( size_t score, size_t max_distance, size_t remaining ) noexcept {
+        return score > max_distance && score - max_distance > remaining;
+    }
+
+    size_t DistanceSingle( std::string_view text, size_t max_distance ) const {
+        const uint64_t last  = uint64_t{ 1 } << ( length_ - 1 );
+        uint64_t       pv    = ~uint64_t{ 0 };
+        uint64_t       mv    = 0;
+        size_t         score = length_;
+        for ( size_t j = 0; j < text.size(); ++j ) {
+            const uint64_t eq = single_peq_[static_cast<unsigned char>( text[j] )];
+            const uint64_t xv = eq | mv;
+            const uint64_t xh = ( ( ( eq & pv ) + pv ) ^ pv ) | eq;
+            uint64_t       ph = mv | ~( xh | pv );
+            uint64_t       mh = pv & xh;
+            if ( ph & last ) {
+                ++score;
+            }
+            else if ( mh & last ) {
+                --score;
+            }
+            if ( Exceeded( score, max_distance, text.size() - j - 1 ) ) {
+                return std::string_view::npos;
+            }
+            // 第0行 D[0][j] = j，水平差分恒为 +1
+            ph = ( ph << 1 ) | 1;
+            mh <<= 1;
+            pv = mh | ~( xv | ph );
+            mv = ph & xv;
+        }
+        return score <= max_distance ? score : std::string_view::npos;
+    }
+
+    size_t DistanceMulti( std::string_view text, size_t max_distance ) const {
+        // 各块状态复用成员缓冲区，批量比较时不再逐次分配
+        std::fill( pv_.begin(), pv_.end(), ~uint64_t{ 0 } );
+        std::fill( mv_.begin(), mv_.end(), 0 );
+        uint64_t      *pv    = pv_.data();
+        uint64_t      *mv    = mv_.data();
+        const uint64_t last  = uint64_t{ 1 } << ( ( length_ - 1 ) % 64 );
+        size_t         score = length_;
+        for ( size_t j = 0; j < text.size(); ++j ) {
+            const uint64_t *peq = &multi_peq_[static_cast<unsigned char>( text[j] ) * blocks_];
+            int             carry = 1;  // 传入当前块顶行的水平差分
+            for ( size_t b = 0; b < blocks_; ++b ) {
+                uint64_t       eq = peq[b];
+                const uint64_t xv = eq | mv[b];
+                if ( carry < 0 ) {
+                    eq |= 1;
+                }
+                const uint64_t xh  = ( ( ( eq & pv[b] ) + pv[b] ) ^ pv[b] ) | eq;
+                uint64_t       ph  = mv[b] | ~( xh | pv[b] );
+                uint64_t       mh  = pv[b] & xh;
+                const uint64_t top = b + 1 == blocks_ ? last : uint64_t{ 1 } << 63;
+                const int      out = ( ph & top ) ? 1 : ( ( mh & top ) ? -1 : 0 );
+                ph <<= 1;
+                mh <<= 1;
+                if ( carry < 0 ) {
+                    mh |= 1;
+                }
+                else if ( carry > 0 ) {
+                    ph |= 1;
+                }
+                pv[b] = mh | ~( xv | ph );
+                mv[b] = ph & xv;
+                carry = out;
+            }
+            score += carry;
+            if ( Exceeded( score, max_distance, text.size() - j - 1 ) ) {
+                return std::string_view::npos;
+            }
+        }
+        return score <= max_distance ? score : std::string_view::npos;
+    }
+
+    size_t                        length_;
+    size_t                        blocks_;
+    std::array<uint64_t, 256>     single_peq_{};
+    std::vector<uint64_t>         multi_peq_;  ///< [byte * blocks_ + block]
+    mutable std::vector<uint64_t> pv_;         ///< 多块时各块的 Pv（计算用的临时状态，不可跨线程共享）
+    mutable std::vector<uint64_t> mv_;         ///< 多块时各块的 Mv
+};
+
+/// 去掉公共前缀和后缀，不影响编辑距离
+void TrimCommonAffix( std::string_view &str1, std::string_view &str2 ) noexcept {
+    const size_t max_prefix = std::min( str1.size(), str2.size() );
+    size_t       prefix     = 0;
+    while ( prefix < max_prefix && str1[prefix] == str2[prefix] ) {
+        ++prefix;
+    }
+    str1.remove_prefix( prefix );
+    str2.remove_prefix( prefix );
+
+    size_t suffix = 0;
+    while ( suffix < str1.size() && suffix < str2.size() &&
+            str1[str1.size() - 1 - suffix] == str2[str2.size() - 1 - suffix] ) {
+        ++suffix;
+    }
+    str1.remove_suffix( suffix );
+    str2.remove_suffix( suffix );
+}
+
+size_t BoundedEditDistance( std::string_view str1, std::string_view str2, size_t max_distance ) {
+    TrimCommonAffix( str1, str2 );
+    // 较短的一方作为模式串，分块数更少
+    if ( str1.size() > str2.size() ) {
+        std::swap( str1, str2 );
+    }
+    return MyersPattern( str1 ).Distance( str2, max_distance );
+}
+
+}  // namespace
+
+size_t StringUtil::EditDistance( std::string_view str1, std::string_view str2 ) {
+    return BoundedEditDistance( str1, str2, std::numeric_limits<size_t>::max() );
+}
+
+std::optional<size_t> StringUtil::EditDistanceBounded( std::string_view str1, std::string_view str2,
+                                                       size_t max_distance ) {
+    const size_t distance = BoundedEditDistance( str1, str2, max_distance );
+    if ( distance == std::string_view::npos ) {
+        return std::nullopt;
+    }
+    return distance;
+}
+
+std::optional<FuzzyMatch> StringUtil::FuzzyFindBest( std::string_view                     query,
+                                                     const std::vector<std::string_view> &candidates,
+                                                     size_t                               max_distance ) {
+    const MyersPattern        pattern( query );
+    std::optional<FuzzyMatch> best;
+    size_t                    limit = max_distance;
+    for ( size_t i = 0; i < candidates.size(); ++i ) {
+        const size_t distance = pattern.Distance( candidates[i], limit );
+        if ( distance == std::string_view::npos ) {
+            continue;
+        }
+        best = FuzzyMatch{ i, distance };
+        if ( distance == 0 ) {
+            break;
+        }
+        // 之后只接受严格更优的候选，距离相同时保留下标较小者
+        limit = distance - 1;
+    }
+    return best;
+}
+
 }  // namespace utils
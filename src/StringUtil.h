@@ -1,13 +1,20 @@
 #pragma once
 
+#include "AhoCorasick.h"
+#include "StringBuilder.h"
 #include <charconv>
+#include <cstdint>
 #include <iomanip>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace utils {
@@ -22,6 +29,483 @@ struct IsStringType : std::conjunction<CanConvertToString<Args>...> {};
 template <typename T>
 constexpr bool IsStringType_v = IsStringType<T>::value;
 
+/**
+ * @brief 预编译的字符集合，用于快速判断字节是否属于某个集合
+ *
+ * 内部以256位位图保存集合成员，同时尝试生成PSHUFB半字节查找表：
+ * 若集合可用不超过8个桶精确表示（绝大多数分隔符/空白/字母数字集合都满足），
+ * 查找类接口会在支持SSSE3/AVX2的CPU上每次分类16/32字节，否则回退到位图逐字节判断。
+ *
+ * @code{.cpp}
+ *   CharSet blank( " \t\r\n" );
+ *   bool result = blank.Contains( '\t' );
+ *   // result = true
+ *
+ *   size_t pos = CharSet::Range( '0', '9' ).FindFirst( "abc123" );
+ *   // pos = 3
+ * @endcode
+ */
+class CharSet {
+public:
+    CharSet() noexcept = default;
+    /**
+     * @brief 由字符列表构造集合
+     * @param chars 集合中的每个字符
+     */
+    explicit CharSet( std::string_view chars ) noexcept;
+    /**
+     * @brief 构造包含闭区间[first, last]内所有字节的集合
+     */
+    [[nodiscard]] static CharSet Range( unsigned char first, unsigned char last ) noexcept;
+
+    /// 集合并
+    [[nodiscard]] CharSet operator|( const CharSet &other ) const noexcept;
+
+    /// 判断字节是否属于集合
+    [[nodiscard]] bool Contains( char c ) const noexcept {
+        const auto uc = static_cast<unsigned char>( c );
+        return ( bits_[uc >> 6] >> ( uc & 63 ) ) & 1;
+    }
+    /**
+     * @brief 查找第一个属于集合的字节
+     * @return 位置；不存在时返回 std::string_view::npos
+     */
+    [[nodiscard]] size_t FindFirst( std::string_view str, size_t pos = 0 ) const noexcept;
+    /**
+     * @brief 查找第一个不属于集合的字节
+     * @return 位置；不存在时返回 std::string_view::npos
+     */
+    [[nodiscard]] size_t FindFirstNot( std::string_view str, size_t pos = 0 ) const noexcept;
+    /**
+     * @brief 查找最后一个不属于集合的字节
+     * @return 位置；不存在时返回 std::string_view::npos
+     */
+    [[nodiscard]] size_t FindLastNot( std::string_view str ) const noexcept;
+    /// 字符串是否全部由集合中的字节组成（空串返回true）
+    [[nodiscard]] bool AllOf( std::string_view str ) const noexcept {
+        return FindFirstNot( str ) == std::string_view::npos;
+    }
+
+private:
+    /// 根据位图生成半字节查找表
+    void Compile() noexcept;
+    size_t Find( std::string_view str, size_t pos, bool negate ) const noexcept;
+
+    uint64_t bits_[4]{};
+    uint8_t  lo_nibble_[16]{};
+    uint8_t  hi_nibble_[16]{};
+    bool     simd_ = false;
+};
+
+/**
+ * @brief 惰性字符串分割范围，按需查找子串，不分配内存
+ *
+ * 分割语义与 StringUtil::SplitRef 完全一致（空分隔符、skip_empty、each_char_as_separator）。
+ * 迭代得到的 std::string_view 引用原始字符串，调用方需保证原始字符串在迭代期间有效。
+ *
+ * @code{.cpp}
+ *   for ( auto part : StringUtil::SplitView( "a,b,,c", ",", true ) ) {
+ *       // part 依次为 "a", "b", "c"
+ *   }
+ * @endcode
+ */
+class SplitRange {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::string_view;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const std::string_view *;
+        using reference         = const std::string_view &;
+
+        Iterator() = default;
+
+        reference operator*() const noexcept { return piece_; }
+        pointer   operator->() const noexcept { return &piece_; }
+
+        Iterator &operator++() noexcept {
+            Advance();
+            return *this;
+        }
+        Iterator operator++( int ) noexcept {
+            Iterator tmp = *this;
+            Advance();
+            return tmp;
+        }
+
+        friend bool operator==( const Iterator &lhs, const Iterator &rhs ) noexcept {
+            if ( lhs.done_ || rhs.done_ ) {
+                return lhs.done_ == rhs.done_;
+            }
+            return lhs.piece_.data() == rhs.piece_.data() && lhs.piece_.size() == rhs.piece_.size() &&
+                   lhs.tail_emitted_ == rhs.tail_emitted_;
+        }
+        friend bool operator!=( const Iterator &lhs, const Iterator &rhs ) noexcept { return !( lhs == rhs ); }
+
+    private:
+        friend class SplitRange;
+
+        Iterator( std::string_view str, std::string_view separator, bool skip_empty,
+                  bool each_char_as_separator ) noexcept
+            : str_( str ),
+              separator_( separator ),
+              skip_empty_( skip_empty ),
+              each_char_as_separator_( each_char_as_separator ),
+              done_( false ) {
+            if ( each_char_as_separator_ ) {
+                separator_set_ = CharSet( separator_ );
+            }
+            Advance();
+        }
+
+        // 查找下一个子串，没有更多子串时置done_
+        void Advance() noexcept {
+            while ( !done_ ) {
+                if ( !NextPiece() ) {
+                    done_ = true;
+                    return;
+                }
+                if ( !skip_empty_ || !piece_.empty() ) {
+                    return;
+                }
+            }
+        }
+
+        bool NextPiece() noexcept {
+            if ( tail_emitted_ ) {
+                return false;
+            }
+            // 空分隔符：首尾各一个空串，中间每个字符一个子串
+            if ( separator_.empty() ) {
+                if ( !head_emitted_ ) {
+                    head_emitted_ = true;
+                    piece_        = str_.substr( 0, 0 );
+                }
+                else if ( pos_ < str_.size() ) {
+                    piece_ = str_.substr( pos_++, 1 );
+                }
+                else {
+                    tail_emitted_ = true;
+                    piece_        = str_.substr( str_.size() );
+                }
+                return true;
+            }
+
+            size_t found   = 0;
+            size_t sep_len = 0;
+            if ( each_char_as_separator_ ) {
+                found   = separator_set_.FindFirst( str_, pos_ );
+                sep_len = 1;
+            }
+            else {
+                found   = str_.find( separator_, pos_ );
+                sep_len = separator_.size();
+            }
+            if ( found == std::string_view::npos ) {
+                tail_emitted_ = true;
+                piece_        = str_.substr( pos_ );
+            }
+            else {
+                piece_ = str_.substr( pos_, found - pos_ );
+                pos_   = found + sep_len;
+            }
+            return true;
+        }
+
+        std::string_view str_;
+        std::string_view separator_;
+        std::string_view piece_;
+        CharSet          separator_set_;
+        size_t           pos_                    = 0;
+        bool             skip_empty_             = false;
+        bool             each_char_as_separator_ = false;
+        bool             head_emitted_           = false;
+        bool             tail_emitted_           = false;
+        bool             done_                   = true;
+    };
+
+    using iterator       = Iterator;
+    using const_iterator = Iterator;
+
+    SplitRange( std::string_view str, std::string_view separator, bool skip_empty = false,
+                bool each_char_as_separator = false ) noexcept
+        : str_( str ),
+          separator_( separator ),
+          skip_empty_( skip_empty ),
+          each_char_as_separator_( each_char_as_separator ) {}
+
+    Iterator begin() const noexcept { return Iterator( str_, separator_, skip_empty_, each_char_as_separator_ ); }
+    Iterator end() const noexcept { return Iterator(); }
+
+    /// 是否没有任何子串
+    bool empty() const noexcept { return begin() == end(); }
+
+private:
+    std::string_view str_;
+    std::string_view separator_;
+    bool             skip_empty_;
+    bool             each_char_as_separator_;
+};
+
+/**
+ * @brief 预编译的多模式替换表，配合 StringUtil::ReplaceMany 使用
+ *
+ * 将所有 from 编译为一个 Aho-Corasick 自动机，构造一次后可重复用于任意多个字符串。
+ * 替换语义为从左到右、不重叠：同一位置有多个 from 可匹配时选择最长的一个；
+ * 空的 from 会被忽略，重复的 from 以第一次出现的为准。
+ *
+ * @code{.cpp}
+ *   ReplaceSet replacements{ { "{name}", "Alice" }, { "{age}", "25" } };
+ *   auto result = StringUtil::ReplaceMany( "{name} is {age}", replacements );
+ *   // result = "Alice is 25"
+ * @endcode
+ */
+class ReplaceSet {
+public:
+    ReplaceSet( std::initializer_list<std::pair<std::string_view, std::string_view>> pairs )
+        : ReplaceSet( std::vector<std::pair<std::string_view, std::string_view>>( pairs ) ) {}
+    /**
+     * @brief 由 from→to 键值对容器构造（如 std::map<std::string, std::string>）
+     */
+    template <typename Container>
+    explicit ReplaceSet( const Container &pairs ) {
+        std::vector<std::string_view> froms;
+        for ( const auto &[from, to] : pairs ) {
+            froms.emplace_back( from );
+            to_.emplace_back( to );
+        }
+        matcher_ = AhoCorasick( froms );
+    }
+
+    /// 编译后的匹配自动机
+    [[nodiscard]] const AhoCorasick &Matcher() const noexcept { return matcher_; }
+    /// 第id个模式串对应的替换内容
+    [[nodiscard]] std::string_view Replacement( size_t id ) const noexcept { return to_[id]; }
+
+private:
+    AhoCorasick              matcher_;
+    std::vector<std::string> to_;
+};
+
+/**
+ * @brief 预编译的多关键字集合，配合 StringUtil::ContainsAny/FindAny 使用
+ *
+ * 按集合规模选择查找策略：
+ *   - 不超过 kMaxPackedNeedles 个关键字且CPU支持AVX2时，每次取32字节，
+ *     对每个关键字同时比较首字节和末字节（packed-pair 过滤），只对两者都命中的位置逐一校验
+ *   - 关键字较多或不支持AVX2时，使用 Aho-Corasick 自动机单遍扫描
+ * 两种策略结果相同：返回最靠左的匹配，同一位置有多个关键字时返回最长的一个。
+ * 空关键字会被忽略；重复的关键字以第一次出现的编号为准。
+ *
+ * @code{.cpp}
+ *   NeedleSet needles{ "password", "token", "secret" };
+ *   auto match = StringUtil::FindAny( "user=a token=xyz", needles );
+ *   // match->pattern = 1 ("token"), match->offset = 7, match->length = 5
+ * @endcode
+ */
+class NeedleSet {
+public:
+    using Match = AhoCorasick::Match;
+
+    /// 使用首尾字节过滤的关键字数量上限
+    static constexpr size_t kMaxPackedNeedles = 16;
+
+    NeedleSet( std::initializer_list<std::string_view> needles )
+        : NeedleSet( std::vector<std::string_view>( needles ) ) {}
+    /**
+     * @brief 由任意字符串容器构造（元素需可转换为 std::string_view）
+     */
+    template <typename Container>
+    explicit NeedleSet( const Container &needles ) {
+        std::vector<std::string_view> views;
+        for ( const auto &needle : needles ) {
+            views.emplace_back( needle );
+        }
+        Build( views );
+    }
+
+    /// 关键字数量（包括被忽略的空关键字）
+    [[nodiscard]] size_t Size() const noexcept { return needles_.size(); }
+    /// 第id个关键字
+    [[nodiscard]] std::string_view Needle( size_t id ) const noexcept { return needles_[id]; }
+    /// 编译后的匹配自动机
+    [[nodiscard]] const AhoCorasick &Matcher() const noexcept { return matcher_; }
+
+private:
+    friend class StringUtil;
+
+    void Build( const std::vector<std::string_view> &needles );
+
+    std::vector<std::string> needles_;
+    AhoCorasick              matcher_;
+    std::vector<std::string> packed_;      ///< 参与首尾字节过滤的关键字（已去除空串和重复），为空表示不使用
+    std::vector<uint32_t>    packed_ids_;  ///< packed_ 中各关键字的编号
+    size_t                   packed_max_length_ = 0;
+};
+
+/**
+ * @brief 预编译的通配符模式（支持 * 和 ?），语义与 StringUtil::WildcardMatch 一致
+ *
+ * 构造时将模式按 '*' 拆分为若干字面片段，并识别常见形态走专用快速路径：
+ *   - 纯字面量（"abc"）：直接比较
+ *   - 前缀（"abc*"）、后缀（"*abc"）：只比较首/尾
+ *   - 一般形态（"a*b?c*d"）：首尾片段锚定比较，中间片段按顺序用 memchr/memcmp 式查找定位，无回溯
+ * 适合同一模式需要匹配大量字符串的场景。
+ *
+ * @code{.cpp}
+ *   WildcardPattern pattern( "*.log" );
+ *   bool result = pattern.Match( "app.log" );
+ *   // result = true
+ *
+ *   std::vector<std::string_view> keys{ "a.log", "b.txt", "c.log" };
+ *   std::vector<size_t> matched;
+ *   pattern.MatchBatch( keys, matched );
+ *   // matched = {0, 2}
+ * @endcode
+ */
+class WildcardPattern {
+public:
+    explicit WildcardPattern( std::string_view pattern );
+
+    /// 判断字符串是否完全匹配该模式
+    [[nodiscard]] bool Match( std::string_view str ) const noexcept;
+
+    /**
+     * @brief 批量匹配一列字符串
+     * @param keys 字符串容器（元素可转换为 std::string_view）
+     * @param matched [out] 匹配成功的元素下标（会先清空，便于调用方复用）
+     */
+    template <typename Container>
+    void MatchBatch( const Container &keys, std::vector<size_t> &matched ) const {
+        matched.clear();
+        size_t index = 0;
+        for ( const auto &key : keys ) {
+            if ( Match( key ) ) {
+                matched.push_back( index );
+            }
+            ++index;
+        }
+    }
+
+    /// 原始模式字符串
+    [[nodiscard]] const std::string &Pattern() const noexcept { return pattern_; }
+
+private:
+    enum class Kind { kAny, kLiteral, kExact, kPrefix, kSuffix, kGeneral };
+
+    /// '*' 之间的片段，以偏移量引用 pattern_，保证对象可安全复制/移动
+    struct Segment {
+        size_t offset;
+        size_t length;
+        size_t anchor_offset;  ///< 片段内最长的不含 '?' 的字面量，用于快速定位
+        size_t anchor_length;
+        bool   has_question;
+    };
+
+    std::string_view View( size_t offset, size_t length ) const noexcept {
+        return std::string_view( pattern_ ).substr( offset, length );
+    }
+    bool   SegmentMatchAt( const Segment &segment, std::string_view str, size_t pos ) const noexcept;
+    size_t FindSegment( const Segment &segment, std::string_view str, size_t begin, size_t end ) const noexcept;
+
+    std::string          pattern_;
+    Kind                 kind_ = Kind::kGeneral;
+    std::vector<Segment> segments_;
+    bool                 leading_star_  = false;
+    bool                 trailing_star_ = false;
+    size_t               min_length_    = 0;  ///< 匹配所需的最小长度（所有片段长度之和）
+};
+
+class LinearRegex;
+
+/// 正则引擎
+enum class RegexEngine {
+    kStd,     ///< std::regex，完整ECMAScript语法，回溯实现，病态模式或超长输入下可能极慢甚至栈溢出
+    kLinear,  ///< LinearRegex，常用子集（不支持反向引用和环视），单次查找耗时与输入长度成线性关系
+};
+
+/**
+ * @brief 预编译的正则表达式句柄
+ *
+ * 编译一次后可在多个线程中反复用于 StringUtil::Extract* 系列函数，避免每次调用重新编译。
+ * 内部以共享指针持有不可变的编译结果，复制开销很小。
+ * 编译时可选择引擎，处理不可信或超大输入时建议使用 RegexEngine::kLinear，
+ * 它不会指数级回溯，但遍历所有匹配时最坏为平方复杂度（见 LinearRegex）。
+ *
+ * @code{.cpp}
+ *   std::string error;
+ *   auto re = CompiledRegex::Compile( R"(\d+)", &error );
+ *   if ( re.Valid() ) {
+ *       auto result = StringUtil::ExtractAll( "a1b22c333", re );
+ *       // result = {"1", "22", "333"}
+ *   }
+ * @endcode
+ */
+class CompiledRegex {
+public:
+    CompiledRegex() = default;
+
+    /**
+     * @brief 编译正则表达式（ECMAScript语法）
+     * @param pattern 正则表达式模式字符串
+     * @param error_msg [out] 可选，编译失败时接收错误描述
+     * @param engine 使用的正则引擎
+     * @return 编译结果；失败时返回无效对象（Valid() == false）
+     */
+    [[nodiscard]] static CompiledRegex Compile( std::string_view pattern, std::string *error_msg = nullptr,
+                                                RegexEngine engine = RegexEngine::kStd );
+
+    /// 是否编译成功
+    [[nodiscard]] bool Valid() const noexcept { return impl_ != nullptr; }
+
+    explicit operator bool() const noexcept { return Valid(); }
+
+    /// 原始模式字符串，无效对象返回空
+    [[nodiscard]] std::string_view Pattern() const noexcept;
+    /// 编译时选择的引擎，无效对象返回 RegexEngine::kStd
+    [[nodiscard]] RegexEngine Engine() const noexcept;
+
+private:
+    friend class StringUtil;
+    friend class RegexStreamExtractor;
+    class Impl;
+
+    /// 线性引擎的编译结果，engine 为 kStd 时返回 nullptr
+    [[nodiscard]] const LinearRegex *Linear() const noexcept;
+
+    std::shared_ptr<const Impl> impl_;
+};
+
+/// StringUtil::Escape / Unescape 支持的转义方言
+enum class EscapeDialect {
+    kC,      ///< C风格，与 EscapeC / UnescapeC 相同
+    kJson,   ///< JSON字符串内容（不含两侧引号），非ASCII字节原样保留
+    kUrl,    ///< URL百分号编码（RFC 3986），只保留非保留字符 A-Z a-z 0-9 - _ . ~
+    kShell,  ///< POSIX shell 单个参数，必要时整体加单引号
+};
+
+/// Base64 字母表（RFC 4648）
+enum class Base64Alphabet {
+    kStandard,  ///< 标准字母表，62/63 为 '+' '/'
+    kUrlSafe,   ///< URL安全字母表，62/63 为 '-' '_'
+};
+
+/// StringUtil::ParseNumbers 的结果
+struct ParseNumbersResult {
+    size_t    count     = 0;                        ///< 成功解析的数值个数
+    size_t    error_pos = std::string_view::npos;  ///< 出错位置在缓冲区中的偏移，成功时为 npos
+    std::errc error     = std::errc{};              ///< 失败原因：invalid_argument 或 result_out_of_range
+
+    explicit operator bool() const noexcept { return error == std::errc{}; }
+};
+
+/// StringUtil::FuzzyFindBest 的结果
+struct FuzzyMatch {
+    size_t index;     ///< 最佳候选在输入中的下标
+    size_t distance;  ///< 与查询串的编辑距离
+};
+
 class StringUtil {
 public:
     /**
@@ -80,6 +564,35 @@ public:
     [[nodiscard]] static std::vector<std::string_view> SplitRef( std::string_view str, std::string_view separator,
                                                                  bool skip_empty             = false,
                                                                  bool each_char_as_separator = false ) noexcept;
+    /**
+     * @brief 惰性分割字符串，返回可迭代的子串引用范围
+     *
+     * 与 SplitRef 语义相同，但不构建 vector，迭代时按需查找下一个子串，全程不分配内存。
+     * 适合只关心前 N 个字段，或需要将字段流式交给解析器的场景。
+     *
+     * @param str 字符串
+     * @param separator 分隔符
+     * @param skip_empty 是否跳过空子串
+     * @param each_char_as_separator 当为true时，将separator中的每个字符都作为独立的分隔符处理
+     * @return SplitRange 子串引用范围（引用str和separator，需保证其生命周期）
+     *
+     * @code{.cpp}
+     *   std::vector<std::string_view> result;
+     *   for ( auto part : SplitView( "a,,b,c", ",", true ) ) {
+     *       result.push_back( part );
+     *   }
+     *   // result = {"a", "b", "c"}
+     *
+     *   auto range = SplitView( "k=v;x=y", ";" );
+     *   auto first = *range.begin();
+     *   // first = "k=v"
+     * @endcode
+     */
+    [[nodiscard]] static SplitRange SplitView( std::string_view str, std::string_view separator,
+                                               bool skip_empty             = false,
+                                               bool each_char_as_separator = false ) noexcept {
+        return SplitRange( str, separator, skip_empty, each_char_as_separator );
+    }
     /**
      * @brief 替换第一个匹配的子串
      * @param str 源字符串
@@ -116,6 +629,78 @@ public:
      */
     [[nodiscard]] static std::string ReplaceAll( std::string_view str, std::string_view from,
                                                  std::string_view to ) noexcept;
+    /**
+     * @brief 原地替换第一个匹配的子串
+     * @param str 待修改的字符串
+     * @param from 要被替换的内容
+     * @param to 替换后的内容
+     * @return 是否发生了替换
+     *
+     * @code{.cpp}
+     *   std::string str = "hello world hello";
+     *   ReplaceFirstInPlace( str, "hello", "hi" );
+     *   // str = "hi world hello"
+     * @endcode
+     */
+    static bool ReplaceFirstInPlace( std::string &str, std::string_view from, std::string_view to );
+    /**
+     * @brief 原地全局替换所有匹配的子串
+     *
+     * 当 to.size() <= from.size() 时单次扫描、就地压缩，不使用额外缓冲区也不分配内存；
+     * 否则记录匹配位置，一次性扩容后从尾部向前填充。
+     * from 与 to 允许引用 str 自身的内容。
+     *
+     * @param str 待修改的字符串
+     * @param from 要被替换的内容
+     * @param to 替换后的内容
+     * @return 替换次数
+     *
+     * @code{.cpp}
+     *   std::string str = "a--b--c";
+     *   auto count = ReplaceAllInPlace( str, "--", "-" );
+     *   // str = "a-b-c", count = 2
+     * @endcode
+     */
+    static size_t ReplaceAllInPlace( std::string &str, std::string_view from, std::string_view to );
+    /**
+     * @brief 将全局替换的结果追加到调用方提供的缓冲区
+     *
+     * 单次扫描，不产生临时字符串；调用方复用 out 时，其容量稳定后不再分配内存。
+     *
+     * @param out 输出缓冲区（结果追加到末尾）
+     * @param str 源字符串（不能引用 out 的内容）
+     * @param from 要被替换的内容
+     * @param to 替换后的内容
+     * @return 替换次数
+     *
+     * @code{.cpp}
+     *   std::string out = "path=";
+     *   AppendReplaced( out, "/a/b/c", "/", "\\" );
+     *   // out = "path=\\a\\b\\c"
+     * @endcode
+     */
+    static size_t AppendReplaced( std::string &out, std::string_view str, std::string_view from,
+                                  std::string_view to );
+    /**
+     * @brief 使用预编译的替换表一次性替换多个子串
+     *
+     * 单次扫描完成所有替换，复杂度与字符串长度成线性关系，与替换对数量无关。
+     * 与多次调用 ReplaceAll 不同，替换结果不会被后续替换对再次匹配。
+     *
+     * @param str 源字符串
+     * @param replacements 预编译的替换表
+     * @return 替换后的字符串
+     *
+     * @code{.cpp}
+     *   ReplaceSet replacements{ { "&", "&amp;" }, { "<", "&lt;" }, { ">", "&gt;" } };
+     *   auto result = ReplaceMany( "<a & b>", replacements );
+     *   // result = "&lt;a &amp; b&gt;"
+     *
+     *   auto result2 = ReplaceMany( "abcd", ReplaceSet{ { "bc", "1" }, { "abc", "2" } } );
+     *   // result2 = "2d" (最左优先，同起点最长优先)
+     * @endcode
+     */
+    [[nodiscard]] static std::string ReplaceMany( std::string_view str, const ReplaceSet &replacements );
     /**
      * @brief 对字符串中的特殊字符进行 C 风格转义
      *
@@ -145,6 +730,16 @@ public:
      * @endcode
      */
     [[nodiscard]] static std::string EscapeC( std::string_view str ) noexcept;
+    /**
+     * @brief EscapeC 的追加版本，转义结果追加到out末尾
+     *
+     * 以SIMD分块查找需要转义的字节，无需转义的片段整段复制，适合以纯ASCII为主的输入；
+     * 调用方复用out可以避免每次分配。
+     *
+     * @param out [out] 输出缓冲区
+     * @param str 输入字符串
+     */
+    static void AppendEscapedC( std::string &out, std::string_view str );
     /**
      * @brief 解码 C 风格转义字符序列
      *
@@ -169,6 +764,65 @@ public:
      * @endcode
      */
     [[nodiscard]] static std::string UnescapeC( std::string_view str ) noexcept;
+    /**
+     * @brief UnescapeC 的追加版本，解码结果追加到out末尾
+     * @param out [out] 输出缓冲区
+     * @param str 已转义的字符串
+     */
+    static void AppendUnescapedC( std::string &out, std::string_view str );
+    /**
+     * @brief 按指定方言转义字符串
+     *
+     * 每种方言由一张256项的动作表描述（原样复制、固定替换串、\\xHH、\\u00HH、%HH），
+     * 以SIMD分块查找需要处理的字节，先统计输出长度，再一次分配、一次写出；无需转义的片段整段复制。
+     *
+     * 各方言规则：
+     *   - kC：同 EscapeC
+     *   - kJson：\" \\ \b \f \n \r \t，其余控制字符为 \u00XX
+     *   - kUrl：非保留字符以外的字节都编码为 %XX（大写）
+     *   - kShell：仅含 A-Z a-z 0-9 @ % + = : , . / _ - 的非空串原样输出，否则整体加单引号，
+     *     内部的单引号写作 '\''
+     *
+     * @param str 输入字符串
+     * @param dialect 转义方言
+     * @return 转义后的字符串
+     *
+     * @code{.cpp}
+     *   auto json  = Escape( "say \"hi\"\n", EscapeDialect::kJson );  // say \"hi\"\n
+     *   auto url   = Escape( "a b&c", EscapeDialect::kUrl );             // a%20b%26c
+     *   auto shell = Escape( "it's", EscapeDialect::kShell );            // 'it'\''s'
+     * @endcode
+     */
+    [[nodiscard]] static std::string Escape( std::string_view str, EscapeDialect dialect );
+    /**
+     * @brief Escape 的追加版本，转义结果追加到out末尾
+     * @param out [out] 输出缓冲区
+     * @param str 输入字符串
+     * @param dialect 转义方言
+     */
+    static void AppendEscaped( std::string &out, std::string_view str, EscapeDialect dialect );
+    /**
+     * @brief 按指定方言解码
+     *
+     * 各方言规则：
+     *   - kC：同 UnescapeC，不会失败
+     *   - kJson：支持全部JSON转义，\uXXXX 编码为UTF-8（代理对合并为一个码点）；非法转义或孤立代理项视为失败
+     *   - kUrl：%XX 解码为对应字节，'+' 保持不变；% 后不是两位十六进制数视为失败
+     *   - kShell：按单个参数解析单引号、双引号和反斜杠转义；引号未闭合视为失败
+     *
+     * @param str 已转义的字符串
+     * @param dialect 转义方言
+     * @return 解码结果；格式非法时返回 std::nullopt
+     */
+    [[nodiscard]] static std::optional<std::string> Unescape( std::string_view str, EscapeDialect dialect );
+    /**
+     * @brief Unescape 的追加版本，解码结果追加到out末尾
+     * @param out [out] 输出缓冲区，失败时保持调用前的内容
+     * @param str 已转义的字符串
+     * @param dialect 转义方言
+     * @return 格式合法时返回 true
+     */
+    static bool AppendUnescaped( std::string &out, std::string_view str, EscapeDialect dialect );
     /**
      * @brief 使用通配符模式匹配字符串（支持 * 和 ?）
      *
@@ -359,6 +1013,42 @@ public:
      * @endcode
      */
     static std::string Trim( std::string_view str ) noexcept;
+    /**
+     * @brief 去除首尾的" \n\r\t\v\f"，返回原字符串的引用，不分配内存
+     *
+     * @param str 字符串
+     * @return 去除空白后的子串引用；全部为空白时返回指向末尾的空引用
+     *
+     * @code{.cpp}
+     *   auto result = TrimRef("  hello world  ");
+     *   // result = "hello world" (string_view引用)
+     * @endcode
+     */
+    [[nodiscard]] static std::string_view TrimRef( std::string_view str ) noexcept;
+    /**
+     * @brief 去除开头的" \n\r\t\v\f"，返回原字符串的引用
+     *
+     * @param str 字符串
+     * @return 去除空白后的子串引用
+     *
+     * @code{.cpp}
+     *   auto result = TrimLeftRef("  hello  ");
+     *   // result = "hello  " (string_view引用)
+     * @endcode
+     */
+    [[nodiscard]] static std::string_view TrimLeftRef( std::string_view str ) noexcept;
+    /**
+     * @brief 去除结尾的" \n\r\t\v\f"，返回原字符串的引用
+     *
+     * @param str 字符串
+     * @return 去除空白后的子串引用
+     *
+     * @code{.cpp}
+     *   auto result = TrimRightRef("  hello  ");
+     *   // result = "  hello" (string_view引用)
+     * @endcode
+     */
+    [[nodiscard]] static std::string_view TrimRightRef( std::string_view str ) noexcept;
     /**
      * @brief 拼接字符串
      *
@@ -379,13 +1069,21 @@ public:
     template <typename... Args>
     [[nodiscard]] static std::string Join( std::string_view separator, Args &&...args ) {
         static_assert( sizeof...( args ) > 0, "Join requires at least one argument" );
-        static_assert( ( IsStringType_v<Args>, ... ), "Join requires argument is string type" );
-        std::ostringstream oss;
-        bool               first = true;
-
-        ( ( oss << ( first ? "" : separator ) << std::forward<Args>( args ), first = false ), ... );
+        static_assert( ( IsStringType_v<Args> && ... ), "Join requires argument is string type" );
+        const std::string_view parts[] = { std::string_view( args )... };
 
-        return oss.str();
+        size_t total = separator.size() * ( sizeof...( args ) - 1 );
+        for ( const auto &part : parts ) {
+            total += part.size();
+        }
+        // 预先计算总长度，结果最多分配一次
+        StringBuilder builder;
+        builder.Reserve( total );
+        builder.Append( parts[0] );
+        for ( size_t i = 1; i < sizeof...( args ); ++i ) {
+            builder.Append( separator ).Append( parts[i] );
+        }
+        return std::move( builder ).ToString();
     }
     /**
      * @brief 针对于字符串容器的拼接函数
@@ -414,7 +1112,22 @@ public:
             return {};
         }
 
-        std::string result;
+        // 先统计总长度，避免拼接过程中反复扩容；char 元素长度为1，无法直接得到长度的元素类型不预留
+        using Element             = decltype( *iter );
+        constexpr bool kCharParts = std::is_same_v<std::decay_t<Element>, char>;
+        std::string    result;
+        if constexpr ( kCharParts || std::is_convertible_v<Element, std::string_view> ) {
+            size_t total = 0;
+            for ( auto it = iter; it != end; ++it ) {
+                if constexpr ( kCharParts ) {
+                    total += separator.size() + 1;
+                }
+                else {
+                    total += separator.size() + std::string_view( *it ).size();
+                }
+            }
+            result.reserve( total - separator.size() );
+        }
         result += *iter;  // 加入第一个元素到结果中
         ++iter;
 
@@ -443,13 +1156,19 @@ public:
      */
     template <typename... Args>
     [[nodiscard]] static std::string FormatCString( std::string_view format, Args &&...args ) {
-        auto size = std::snprintf( nullptr, 0, format.data(), std::forward<Args>( args )... );
+        // 先尝试直接格式化到内联缓冲区，放不下时才按精确长度扩容后重新格式化
+        StringBuilder builder;
+        builder.Resize( builder.Capacity() );
+        auto size = std::snprintf( builder.Data(), builder.Size(), format.data(), args... );
         if ( size < 0 ) {
             throw std::runtime_error( "Format string error in StringUtil::FormatCString" );
         }
-        auto buffer = std::make_unique<char[]>( size + 1 );
-        std::snprintf( buffer.get(), size + 1, format.data(), std::forward<Args>( args )... );
-        return std::string( buffer.get(), size );
+        if ( static_cast<size_t>( size ) >= builder.Size() ) {
+            builder.Resize( static_cast<size_t>( size ) + 1 );
+            std::snprintf( builder.Data(), builder.Size(), format.data(), args... );
+        }
+        builder.Resize( static_cast<size_t>( size ) );
+        return std::move( builder ).ToString();
     }
     /**
      * @brief 生成times个str字符串
@@ -466,121 +1185,436 @@ public:
      *   // result2 = "1/1/1/1/1/"
      * @endcode
      */
-    static std::string Repeat( std::string_view str, unsigned int times );
+    static std::string Repeat( std::string_view str, unsigned int times );
+    /**
+     * @brief 字符串转大写，只转换ASCII字母
+     *
+     * @param str 字符串
+     * @return std::string
+     *
+     * @code{.cpp}
+     *   auto result = ToUpper("Hello World");
+     *   // result = "HELLO WORLD"
+     *
+     *   auto result2 = ToUpper("abc-def");
+     *   // result2 = "ABC-DEF"
+     * @endcode
+     */
+    static std::string ToUpper( std::string_view str );
+    /**
+     * @brief 字符串转小写，只转换ASCII字母
+     *
+     * @param str 字符串
+     * @return std::string
+     *
+     * @code{.cpp}
+     *   auto result = ToLower("Hello World");
+     *   // result = "hello world"
+     *
+     *   auto result2 = ToLower("ABC-DEF");
+     *   // result2 = "abc-def"
+     * @endcode
+     */
+    static std::string ToLower( std::string_view str );
+    /**
+     * @brief 原地转大写，只转换ASCII字母，其余字节保持不变
+     *
+     * 支持AVX2时每次处理32字节。
+     *
+     * @param str [in,out] 字符串
+     *
+     * @code{.cpp}
+     *   std::string header = "content-type";
+     *   ToUpperInPlace( header );
+     *   // header = "CONTENT-TYPE"
+     * @endcode
+     */
+    static void ToUpperInPlace( std::string &str ) noexcept;
+    /**
+     * @brief 原地转小写，只转换ASCII字母，其余字节保持不变
+     *
+     * 支持AVX2时每次处理32字节。
+     *
+     * @param str [in,out] 字符串
+     *
+     * @code{.cpp}
+     *   std::string header = "Content-Type";
+     *   ToLowerInPlace( header );
+     *   // header = "content-type"
+     * @endcode
+     */
+    static void ToLowerInPlace( std::string &str ) noexcept;
+    /**
+     * @brief 检查字符串是否以prefix开头
+     *
+     * @param str
+     * @param prefix
+     * @return true
+     * @return false
+     *
+     * @code{.cpp}
+     *   bool result = StartWith("HelloWorld", "Hello");
+     *   // result = true
+     *
+     *   bool result2 = StartWith("HelloWorld", "World");
+     *   // result2 = false
+     * @endcode
+     */
+    static bool StartWith( std::string_view str, std::string_view prefix );
+    /**
+     * @brief 检查字符串是否以suffix结尾
+     *
+     * @param str
+     * @param suffix
+     * @return true
+     * @return false
+     *
+     * @code{.cpp}
+     *   bool result = EndWith("HelloWorld", "World");
+     *   // result = true
+     *
+     *   bool result2 = EndWith("HelloWorld", "Hello");
+     *   // result2 = false
+     * @endcode
+     */
+    static bool EndWith( std::string_view str, std::string_view suffix );
+    /**
+     * @brief 检查字符串是否包含指定的内容
+     *
+     * @param str
+     * @param token
+     * @return true
+     * @return false
+     *
+     * @code{.cpp}
+     *   bool result = Contains("HelloWorld", "World");
+     *   // result = true
+     *
+     *   bool result2 = Contains("HelloWorld", "xyz");
+     *   // result2 = false
+     * @endcode
+     */
+    static bool Contains( std::string_view str, std::string_view token ) noexcept;
+    /**
+     * @brief 检查字符串是否包含关键字集合中的任意一个
+     *
+     * @param str 字符串
+     * @param needles 预编译的关键字集合
+     * @return true
+     * @return false
+     *
+     * @code{.cpp}
+     *   NeedleSet needles{ "error", "fatal" };
+     *   bool result = ContainsAny( "fatal: disk full", needles );
+     *   // result = true
+     * @endcode
+     */
+    static bool ContainsAny( std::string_view str, const NeedleSet &needles ) noexcept;
+    /**
+     * @brief 从pos开始查找关键字集合中最靠左的匹配，同一位置取最长的关键字
+     *
+     * @param str 字符串
+     * @param needles 预编译的关键字集合
+     * @param pos 起始查找位置
+     * @return 匹配的关键字编号、位置和长度；无匹配时返回 std::nullopt
+     *
+     * @code{.cpp}
+     *   NeedleSet needles{ "he", "she", "hers" };
+     *   auto match = FindAny( "ushers", needles );
+     *   // match->pattern = 1 ("she"), match->offset = 1, match->length = 3
+     * @endcode
+     */
+    [[nodiscard]] static std::optional<NeedleSet::Match> FindAny( std::string_view str, const NeedleSet &needles,
+                                                                  size_t pos = 0 ) noexcept;
+    /**
+     * @brief 转换为十六进制字符串
+     *
+     * @param data 数据
+     * @param separator 分隔符
+     * @return std::string
+     *
+     * @code{.cpp}
+     *   auto result = ConvertToHexStr("ABC");
+     *   // result = "41 42 43"
+     *
+     *   auto result2 = ConvertToHexStr("123", ':');
+     *   // result2 = "31:32:33"
+     * @endcode
+     */
+    static std::string ConvertToHexStr( std::string_view data, char separator = ' ' );
+    /**
+     * @brief 十六进制编码
+     *
+     * 无分隔符时使用SIMD按块编码，否则逐字节查表，结果一次性分配。
+     *
+     * @param data 数据
+     * @param separator 相邻字节之间的分隔符，可为空
+     * @param uppercase 是否使用大写字母
+     * @return 编码结果
+     *
+     * @code{.cpp}
+     *   auto result = HexEncode( "\x12\xAB" );             // "12ab"
+     *   auto result2 = HexEncode( "\x12\xAB", ":", true );  // "12:AB"
+     * @endcode
+     */
+    [[nodiscard]] static std::string HexEncode( std::string_view data, std::string_view separator = {},
+                                                bool uppercase = false );
+    /**
+     * @brief HexEncode 的追加版本，编码结果追加到out末尾
+     * @param out [out] 输出缓冲区
+     * @param data 数据
+     * @param separator 相邻字节之间的分隔符，可为空
+     * @param uppercase 是否使用大写字母
+     */
+    static void AppendHexEncoded( std::string &out, std::string_view data, std::string_view separator = {},
+                                  bool uppercase = false );
+    /**
+     * @brief 十六进制解码，大小写均可
+     *
+     * 输入必须严格为“两位十六进制数”序列，相邻两组之间恰好是一个 separator。
+     *
+     * @param hex 十六进制字符串
+     * @param separator 相邻字节之间的分隔符，可为空
+     * @return 解码结果；长度、分隔符或字符非法时返回 std::nullopt
+     *
+     * @code{.cpp}
+     *   auto result = HexDecode( "12ab" );        // "\x12\xAB"
+     *   auto result2 = HexDecode( "12 AB", " " );  // "\x12\xAB"
+     *   auto result3 = HexDecode( "12a" );        // std::nullopt
+     * @endcode
+     */
+    [[nodiscard]] static std::optional<std::string> HexDecode( std::string_view hex, std::string_view separator = {} );
+    /**
+     * @brief HexDecode 的追加版本，解码结果追加到out末尾
+     * @param out [out] 输出缓冲区，失败时保持调用前的内容
+     * @param hex 十六进制字符串
+     * @param separator 相邻字节之间的分隔符，可为空
+     * @return 格式合法时返回 true
+     */
+    static bool AppendHexDecoded( std::string &out, std::string_view hex, std::string_view separator = {} );
+    /**
+     * @brief Base64 编码
+     *
+     * 支持AVX2时按块编码，否则逐组查表，结果一次性分配。大文件可使用 Base64StreamEncoder 分块编码。
+     *
+     * @param data 数据
+     * @param alphabet 字母表
+     * @param padding 是否补齐 '='
+     * @return 编码结果
+     *
+     * @code{.cpp}
+     *   auto result = Base64Encode( "hello" );                                    // "aGVsbG8="
+     *   auto result2 = Base64Encode( "\xFB\xFF", Base64Alphabet::kUrlSafe, false );  // "-_8"
+     * @endcode
+     */
+    [[nodiscard]] static std::string Base64Encode( std::string_view data,
+                                                   Base64Alphabet   alphabet = Base64Alphabet::kStandard,
+                                                   bool             padding  = true );
+    /**
+     * @brief Base64Encode 的追加版本，编码结果追加到out末尾
+     * @param out [out] 输出缓冲区
+     * @param data 数据
+     * @param alphabet 字母表
+     * @param padding 是否补齐 '='
+     */
+    static void AppendBase64Encoded( std::string &out, std::string_view data,
+                                     Base64Alphabet alphabet = Base64Alphabet::kStandard, bool padding = true );
+    /**
+     * @brief Base64 解码
+     *
+     * 严格模式只接受 Base64Encode 可能产生的输出：仅含所选字母表的字符，'=' 可省略但出现时必须完整，
+     * 末尾未使用的比特必须为0。
+     * 宽松模式额外忽略空白字符，同时接受两种字母表的 62/63 字符，允许不完整的填充，并忽略末尾多余比特。
+     *
+     * @param str Base64 字符串
+     * @param alphabet 字母表
+     * @param strict 是否使用严格模式
+     * @return 解码结果；格式非法时返回 std::nullopt
+     *
+     * @code{.cpp}
+     *   auto result = Base64Decode( "aGVsbG8=" );                                         // "hello"
+     *   auto result2 = Base64Decode( "aGVs\nbG8", Base64Alphabet::kStandard, false );  // "hello"
+     *   auto result3 = Base64Decode( "aGVs\nbG8" );                                       // std::nullopt
+     * @endcode
+     */
+    [[nodiscard]] static std::optional<std::string> Base64Decode( std::string_view str,
+                                                                  Base64Alphabet alphabet = Base64Alphabet::kStandard,
+                                                                  bool           strict   = true );
+    /**
+     * @brief Base64Decode 的追加版本，解码结果追加到out末尾
+     * @param out [out] 输出缓冲区，失败时保持调用前的内容
+     * @param str Base64 字符串
+     * @param alphabet 字母表
+     * @param strict 是否使用严格模式
+     * @return 格式合法时返回 true
+     */
+    static bool AppendBase64Decoded( std::string &out, std::string_view str,
+                                     Base64Alphabet alphabet = Base64Alphabet::kStandard, bool strict = true );
+    /**
+     * @brief 忽略ASCII大小写的字符串比较
+     *
+     * 支持AVX2时每次比较32字节。
+     *
+     * @param str1 第一个字符串
+     * @param str2 第二个字符串
+     * @return true 如果两个字符串相等（忽略大小写）
+     * @return false 如果两个字符串不相等
+     *
+     * @code{.cpp}
+     *   bool result = EqualsIgnoreCase("Hello", "hello");
+     *   // result = true
+     *
+     *   bool result2 = EqualsIgnoreCase("Hello", "world");
+     *   // result2 = false
+     * @endcode
+     */
+    static bool EqualsIgnoreCase( std::string_view str1, std::string_view str2 ) noexcept;
     /**
-     * @brief 字符串转大写
+     * @brief 忽略ASCII大小写查找子串
+     *
+     * 支持AVX2时先用首尾字节过滤每32个候选位置，再逐个校验。
      *
      * @param str 字符串
-     * @return std::string
+     * @param token 要查找的子串
+     * @param pos 起始位置
+     * @return 第一次出现的位置，未找到返回 std::string_view::npos
      *
      * @code{.cpp}
-     *   auto result = ToUpper("Hello World");
-     *   // result = "HELLO WORLD"
-     *
-     *   auto result2 = ToUpper("abc-def");
-     *   // result2 = "ABC-DEF"
+     *   size_t result = FindIgnoreCase("Content-Type: text/html", "TYPE");
+     *   // result = 8
      * @endcode
      */
-    static std::string ToUpper( std::string_view str );
+    static size_t FindIgnoreCase( std::string_view str, std::string_view token, size_t pos = 0 ) noexcept;
     /**
-     * @brief 字符串转小写
+     * @brief 忽略ASCII大小写检查是否包含子串
      *
      * @param str 字符串
-     * @return std::string
+     * @param token 要查找的子串
+     * @return true 如果包含
      *
      * @code{.cpp}
-     *   auto result = ToLower("Hello World");
-     *   // result = "hello world"
-     *
-     *   auto result2 = ToLower("ABC-DEF");
-     *   // result2 = "abc-def"
+     *   bool result = ContainsIgnoreCase("Keep-Alive", "alive");
+     *   // result = true
      * @endcode
      */
-    static std::string ToLower( std::string_view str );
+    static bool ContainsIgnoreCase( std::string_view str, std::string_view token ) noexcept;
     /**
-     * @brief 检查字符串是否以prefix开头
+     * @brief 忽略ASCII大小写检查字符串是否以prefix开头
      *
-     * @param str
-     * @param prefix
-     * @return true
-     * @return false
+     * @param str 字符串
+     * @param prefix 前缀
+     * @return true 如果以prefix开头
      *
      * @code{.cpp}
-     *   bool result = StartWith("HelloWorld", "Hello");
+     *   bool result = StartWithIgnoreCase("Content-Length: 12", "content-length:");
      *   // result = true
-     *
-     *   bool result2 = StartWith("HelloWorld", "World");
-     *   // result2 = false
      * @endcode
      */
-    static bool StartWith( std::string_view str, std::string_view prefix );
+    static bool StartWithIgnoreCase( std::string_view str, std::string_view prefix ) noexcept;
     /**
-     * @brief 检查字符串是否以suffix结尾
+     * @brief 忽略ASCII大小写检查字符串是否以suffix结尾
      *
-     * @param str
-     * @param suffix
-     * @return true
-     * @return false
+     * @param str 字符串
+     * @param suffix 后缀
+     * @return true 如果以suffix结尾
      *
      * @code{.cpp}
-     *   bool result = EndWith("HelloWorld", "World");
+     *   bool result = EndWithIgnoreCase("index.HTML", ".html");
      *   // result = true
-     *
-     *   bool result2 = EndWith("HelloWorld", "Hello");
-     *   // result2 = false
      * @endcode
      */
-    static bool EndWith( std::string_view str, std::string_view suffix );
+    static bool EndWithIgnoreCase( std::string_view str, std::string_view suffix ) noexcept;
     /**
-     * @brief 检查字符串是否包含指定的内容
+     * @brief 计算64位非密码学哈希（wyhash 算法）
      *
-     * @param str
-     * @param token
-     * @return true
-     * @return false
+     * 速度远高于 std::hash<std::string>，分布质量可用于哈希表和分片；结果依赖字节序，不应持久化或跨平台比较。
      *
-     * @code{.cpp}
-     *   bool result = Contains("HelloWorld", "World");
-     *   // result = true
+     * @param str 字符串
+     * @param seed 种子
+     * @return uint64_t
      *
-     *   bool result2 = Contains("HelloWorld", "xyz");
-     *   // result2 = false
+     * @code{.cpp}
+     *   uint64_t h = Hash( "hello" );
      * @endcode
      */
-    static bool Contains( std::string_view str, std::string_view token ) noexcept;
+    [[nodiscard]] static uint64_t Hash( std::string_view str, uint64_t seed = 0 ) noexcept;
     /**
-     * @brief 转换为十六进制字符串
+     * @brief 忽略ASCII大小写的64位哈希，与 EqualsIgnoreCase 一致：相等的字符串哈希值相同
      *
-     * @param data 数据
-     * @param separator 分隔符
-     * @return std::string
+     * 读取时按8字节批量转小写，不需要先复制出小写字符串。
      *
-     * @code{.cpp}
-     *   auto result = ConvertToHexStr("ABC");
-     *   // result = "41 42 43"
+     * @param str 字符串
+     * @param seed 种子
+     * @return uint64_t 与 Hash( ToLower( str ), seed ) 相同
+     */
+    [[nodiscard]] static uint64_t HashIgnoreCase( std::string_view str, uint64_t seed = 0 ) noexcept;
+    /**
+     * @brief 计算两个字符串的编辑距离（Levenshtein，按字节计算插入、删除、替换）
      *
-     *   auto result2 = ConvertToHexStr("123", ':');
-     *   // result2 = "31:32:33"
+     * 使用 Myers 位并行算法：较短的字符串按64字节分块，每块一个64位字，
+     * 每处理较长字符串的一个字节只需若干次位运算，复杂度 O(⌈m/64⌉·n)。计算前会先去掉公共前缀和后缀。
+     *
+     * @param str1 字符串1
+     * @param str2 字符串2
+     * @return size_t
+     *
+     * @code{.cpp}
+     *   size_t result = EditDistance("kitten", "sitting");
+     *   // result = 3
      * @endcode
      */
-    static std::string ConvertToHexStr( std::string_view data, char separator = ' ' );
+    [[nodiscard]] static size_t EditDistance( std::string_view str1, std::string_view str2 );
     /**
-     * @brief 忽略大小写的字符串比较
+     * @brief 计算编辑距离，确定超过 max_distance 时立即返回
      *
-     * @param str1 第一个字符串
-     * @param str2 第二个字符串
-     * @return true 如果两个字符串相等（忽略大小写）
-     * @return false 如果两个字符串不相等
+     * 长度差超过阈值时不做计算；计算过程中一旦剩余字节不足以把距离降回阈值以内即提前结束。
+     *
+     * @param str1 字符串1
+     * @param str2 字符串2
+     * @param max_distance 距离阈值
+     * @return 距离不超过 max_distance 时返回距离，否则返回 std::nullopt
      *
      * @code{.cpp}
-     *   bool result = EqualsIgnoreCase("Hello", "hello");
-     *   // result = true
+     *   auto result = EditDistanceBounded("kitten", "sitting", 2);
+     *   // result = std::nullopt
+     * @endcode
+     */
+    [[nodiscard]] static std::optional<size_t> EditDistanceBounded( std::string_view str1, std::string_view str2,
+                                                                    size_t max_distance );
+    /**
+     * @brief 在一批候选中查找与 query 编辑距离最小的一个
      *
-     *   bool result2 = EqualsIgnoreCase("Hello", "world");
-     *   // result2 = false
+     * query 的位并行匹配表只构建一次；每个候选都以当前最优距离为阈值计算，较差的候选会很快被淘汰。
+     * 距离相同时返回下标较小的候选。
+     *
+     * @param query 查询串
+     * @param candidates 候选列表
+     * @param max_distance 可接受的最大距离，默认不限制
+     * @return 最佳候选的下标及距离；没有候选在阈值以内时返回 std::nullopt
+     *
+     * @code{.cpp}
+     *   std::vector<std::string_view> commands{ "status", "commit", "checkout" };
+     *   auto best = FuzzyFindBest( "comit", commands, 2 );
+     *   // best->index = 1, best->distance = 1
      * @endcode
      */
-    static bool EqualsIgnoreCase( std::string_view str1, std::string_view str2 ) noexcept;
+    [[nodiscard]] static std::optional<FuzzyMatch> FuzzyFindBest(
+        std::string_view query, const std::vector<std::string_view> &candidates,
+        size_t max_distance = std::numeric_limits<size_t>::max() );
+    /**
+     * @brief FuzzyFindBest 的容器版本（元素需可转换为 std::string_view）
+     */
+    template <typename Container>
+    [[nodiscard]] static std::optional<FuzzyMatch> FuzzyFindBest(
+        std::string_view query, const Container &candidates,
+        size_t max_distance = std::numeric_limits<size_t>::max() ) {
+        std::vector<std::string_view> views;
+        views.reserve( std::size( candidates ) );
+        for ( const auto &candidate : candidates ) {
+            views.emplace_back( candidate );
+        }
+        return FuzzyFindBest( query, views, max_distance );
+    }
     /**
      * @brief 转换为二进制字符串
      *
@@ -607,7 +1641,7 @@ public:
      * @return std::optional<T> 转换成功则返回值；若输入为空、包含非法字符或无法完全解析，则返回 std::nullopt
      *
      * @note
-     * - 忽略首尾空白字符
+     * - 忽略首尾空白字符，整个过程不分配内存
      * - 要求整个字符串为合法数字表示，**不允许部分匹配**（如 "123abc" 会失败）
      * - 对于任何非合法数字格式的输入（除空白外），均返回 std::nullopt
      * - 浮点数不保证支持 "inf" 或 "nan"
@@ -635,10 +1669,7 @@ public:
     template <typename T>
     static std::optional<T> ToNumber( std::string_view str ) noexcept {
         static_assert( std::is_arithmetic_v<T>, "ToNumber only supports arithmetic types" );
-        if ( str.empty() ) {
-            return std::nullopt;
-        }
-        str = Trim( str );
+        str = TrimRef( str );
         if ( str.empty() ) {
             return std::nullopt;
         }
@@ -670,16 +1701,72 @@ public:
         }
         return value;
     }
+    /**
+     * @brief 批量解析以单个字符分隔的数值字段
+     *
+     * 用于加载CSV等大批量数值数据：不为字段创建任何临时字符串，结果写入调用方复用的 vector。
+     * 整型按十进制解析（可带 '+' 或 '-' 号），每次用SWAR校验并转换8位数字；浮点型使用 std::from_chars。
+     *
+     * @tparam T 目标数值类型，必须是算术类型
+     * @param buffer 输入缓冲区
+     * @param delim 字段分隔符
+     * @param out [out] 输出数组，先被清空（保留容量），出错时保留出错字段之前的结果
+     * @return 解析结果，出错时 error_pos 指向第一个非法字符（空字段指向字段起点，超出范围指向数值起点）
+     *
+     * @note
+     * - 忽略每个字段首尾的空白字符
+     * - 最后一个分隔符之后的空字段被忽略（如 "1\n2\n" 以 '\n' 分隔时得到两个数）
+     *
+     * @code{.cpp}
+     *   std::vector<int> values;
+     *   auto result = ParseNumbers( "1, 2, 3", ',', values );
+     *   // result.count = 3, values = {1, 2, 3}
+     *
+     *   auto result2 = ParseNumbers( "1,2x,3", ',', values );
+     *   // !result2, result2.error_pos = 3, values = {1}
+     * @endcode
+     */
+    template <typename T>
+    static ParseNumbersResult ParseNumbers( std::string_view buffer, char delim, std::vector<T> &out ) {
+        static_assert( std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                       "ParseNumbers only supports arithmetic types" );
+        out.clear();
+        ParseNumbersResult result;
+        size_t             pos = 0;
+        while ( pos <= buffer.size() ) {
+            size_t next = buffer.find( delim, pos );
+            if ( next == std::string_view::npos ) {
+                next = buffer.size();
+            }
+            const std::string_view field = TrimRef( buffer.substr( pos, next - pos ) );
+            if ( field.empty() && next == buffer.size() ) {
+                break;
+            }
+
+            T           value{};
+            const char *error_at = nullptr;
+            result.error         = ParseNumberField( field, value, error_at );
+            if ( result.error != std::errc{} ) {
+                result.error_pos = field.empty() ? pos : static_cast<size_t>( error_at - buffer.data() );
+                return result;
+            }
+            out.push_back( value );
+            ++result.count;
+            pos = next + 1;
+        }
+        return result;
+    }
     /**
      * @brief 将数值类型转换为字符串
      *
-     * 整型支持 8、10、16 进制，浮点型支持指定小数位数（%f）或自动格式（%g）
+     * 整型支持 8、10、16 进制；浮点型支持指定小数位数（%f），或输出可精确还原原值的最短表示。
+     * 基于 std::to_chars 写入栈上缓冲区，不构造任何流对象。
      *
      * @tparam T 数值类型（必须是算术类型）
      * @param value 输入数值
      * @param base 整型进制（仅整型有效），可选 8、10、16；默认 10
-     * @param precision 小数位数（仅浮点型有效），-1 表示自动精度（%g），>=0 表示固定小数位（%f）
-     * @return std::string 转换成功则返回结果；失败（如参数非法、缓冲区溢出等）则返回空字符串 ""
+     * @param precision 小数位数（仅浮点型有效），负数表示最短往返表示，>=0 表示固定小数位（%f）
+     * @return std::string 转换成功则返回结果；失败（如参数非法等）则返回空字符串 ""
      *
      * @code{.cpp}
      *   auto result = FromNumber<int>(42);
@@ -691,52 +1778,92 @@ public:
      *   auto result3 = FromNumber<double>(3.14159, 10, 2);
      *   // result3 = "3.14"
      *
-     *   auto result4 = FromNumber<double>(3.14159, 10, -1);
-     *   // result4 = "3.14159" (自动格式)
+     *   auto result4 = FromNumber<double>(0.1 + 0.2);
+     *   // result4 = "0.30000000000000004" (最短往返表示)
      * @endcode
      */
     template <typename T>
     static std::string FromNumber( T value, int base = 10, int precision = -1 ) noexcept {
         static_assert( std::is_arithmetic_v<T>, "FromNumber only supports arithmetic types" );
-        if constexpr ( std::is_integral_v<T> ) {
-            char                 buffer[64]{};
-            std::to_chars_result result;
-            switch ( base ) {
-                case 8:
-                    result = std::to_chars( buffer, buffer + sizeof( buffer ), value, 8 );
-                    break;
-                case 10:
-                    result = std::to_chars( buffer, buffer + sizeof( buffer ), value );
-                    break;
-                case 16:
-                    result = std::to_chars( buffer, buffer + sizeof( buffer ), value, 16 );
-                    break;
-                default:
-                    return {};
-            }
-            if ( result.ec != std::errc{} ) {
-                return {};
-            }
-            return std::string( buffer, static_cast<size_t>( result.ptr - buffer ) );
+        char        buffer[kNumberBufferSize];
+        const char *end = FormatNumberTo( buffer, buffer + sizeof( buffer ), value, base, precision );
+        if ( end ) {
+            return std::string( buffer, static_cast<size_t>( end - buffer ) );
         }
-        else if constexpr ( std::is_floating_point_v<T> ) {
-            std::ostringstream oss;
+        // 只有大数值的定点格式会超出栈缓冲区
+        if constexpr ( std::is_floating_point_v<T> ) {
             try {
-                if ( precision >= 0 ) {
-                    oss << std::fixed << std::setprecision( precision ) << value;
-                }
-                else {
-                    oss << std::defaultfloat << value;
-                }
-                const std::string &str = oss.str();
-                return str.empty() ? std::string{} : str;
+                std::string result;
+                AppendNumber( result, value, base, precision );
+                return result;
             }
             catch ( ... ) {
-                return {};
             }
         }
         return {};
     }
+    /**
+     * @brief 将数值格式化到调用方提供的缓冲区，规则与 FromNumber 相同
+     *
+     * @tparam T 数值类型（必须是算术类型）
+     * @param first 缓冲区起点
+     * @param last 缓冲区终点
+     * @param value 输入数值
+     * @param base 整型进制（仅整型有效），可选 8、10、16
+     * @param precision 小数位数（仅浮点型有效），负数表示最短往返表示
+     * @return 写入内容的末尾（不写入结束符）；参数非法或缓冲区不足时返回 nullptr
+     *
+     * @code{.cpp}
+     *   char buffer[64];
+     *   char *end = FormatNumberTo( buffer, buffer + sizeof( buffer ), 2.5 );
+     *   // std::string_view( buffer, end - buffer ) = "2.5"
+     * @endcode
+     */
+    template <typename T>
+    static char *FormatNumberTo( char *first, char *last, T value, int base = 10, int precision = -1 ) noexcept {
+        static_assert( std::is_arithmetic_v<T>, "FormatNumberTo only supports arithmetic types" );
+        std::to_chars_result result{};
+        if constexpr ( std::is_same_v<T, bool> ) {
+            result = std::to_chars( first, last, static_cast<int>( value ), base );
+        }
+        else if constexpr ( std::is_integral_v<T> ) {
+            if ( base != 8 && base != 10 && base != 16 ) {
+                return nullptr;
+            }
+            result = std::to_chars( first, last, value, base );
+        }
+        else {
+            result = precision >= 0 ? std::to_chars( first, last, value, std::chars_format::fixed, precision )
+                                    : std::to_chars( first, last, value );
+        }
+        return result.ec == std::errc{} ? result.ptr : nullptr;
+    }
+    /**
+     * @brief 将数值格式化后追加到out末尾，规则与 FromNumber 相同
+     *
+     * @param out [out] 输出缓冲区
+     * @param value 输入数值
+     * @param base 整型进制（仅整型有效），可选 8、10、16
+     * @param precision 小数位数（仅浮点型有效），负数表示最短往返表示
+     * @return 参数非法时返回 false，out 保持不变
+     */
+    template <typename T>
+    static bool AppendNumber( std::string &out, T value, int base = 10, int precision = -1 ) {
+        static_assert( std::is_arithmetic_v<T>, "AppendNumber only supports arithmetic types" );
+        size_t capacity = kNumberBufferSize;
+        if constexpr ( std::is_floating_point_v<T> ) {
+            // 定点格式的整数部分最多 max_exponent10 + 1 位
+            if ( precision >= 0 ) {
+                capacity = static_cast<size_t>( std::numeric_limits<T>::max_exponent10 ) + 4 +
+                           static_cast<size_t>( precision );
+            }
+        }
+        const size_t start = out.size();
+        out.resize( start + capacity );
+        char *end = FormatNumberTo( out.data() + start, out.data() + out.size(), value, base, precision );
+        out.resize( end ? static_cast<size_t>( end - out.data() ) : start );
+        return end != nullptr;
+    }
     /**
      * @brief 提取字符串片段
      *
@@ -766,6 +1893,7 @@ public:
      *
      * 使用指定正则表达式搜索输入文本，返回首个完整匹配结果。
      * 若未找到匹配项或正则编译失败，则返回空 optional。
+     * 编译结果会进入LRU缓存（见 SetRegexCacheCapacity），热点模式不会重复编译。
      *
      * @param text 输入文本（支持 std::string_view 避免拷贝）
      * @param pattern 正则表达式模式字符串
@@ -786,6 +1914,9 @@ public:
      */
     static std::optional<std::string> ExtractFirst( std::string_view text, std::string_view pattern,
                                                     std::string *error_msg = nullptr );
+    /// ExtractFirst 的预编译正则版本
+    static std::optional<std::string> ExtractFirst( std::string_view text, const CompiledRegex &regex,
+                                                    std::string *error_msg = nullptr );
     /**
      * @brief 提取第一个匹配中的指定捕获组内容
      *
@@ -811,6 +1942,9 @@ public:
      */
     static std::optional<std::string> ExtractGroup( std::string_view text, std::string_view pattern,
                                                     size_t group_index = 1, std::string *error_msg = nullptr );
+    /// ExtractGroup 的预编译正则版本
+    static std::optional<std::string> ExtractGroup( std::string_view text, const CompiledRegex &regex,
+                                                    size_t group_index = 1, std::string *error_msg = nullptr );
     /**
      * @brief 全局提取所有完整匹配项（非重叠）
      *
@@ -834,6 +1968,9 @@ public:
      */
     static std::vector<std::string> ExtractAll( std::string_view text, std::string_view pattern,
                                                 std::string *error_msg = nullptr );
+    /// ExtractAll 的预编译正则版本
+    static std::vector<std::string> ExtractAll( std::string_view text, const CompiledRegex &regex,
+                                                std::string *error_msg = nullptr );
     /**
      * @brief 全局提取所有匹配中的指定捕获组内容
      *
@@ -860,6 +1997,33 @@ public:
      */
     static std::vector<std::string> ExtractAllGroups( std::string_view text, std::string_view pattern,
                                                       size_t group_index = 1, std::string *error_msg = nullptr );
+    /// ExtractAllGroups 的预编译正则版本
+    static std::vector<std::string> ExtractAllGroups( std::string_view text, const CompiledRegex &regex,
+                                                      size_t group_index = 1, std::string *error_msg = nullptr );
+    /**
+     * @brief 设置正则缓存容量
+     *
+     * 以字符串形式传入正则的 Extract* 函数会把编译结果放入一个线程安全的LRU缓存，
+     * 相同模式再次使用时不再重新编译。容量为0时禁用缓存。默认容量为128。
+     *
+     * @param capacity 最多缓存的正则数量
+     */
+    static void SetRegexCacheCapacity( size_t capacity );
+    /// 清空正则缓存
+    static void ClearRegexCache();
+    /**
+     * @brief 设置以字符串形式传入正则的 Extract* 函数使用的引擎
+     *
+     * 默认为 RegexEngine::kStd。切换为 RegexEngine::kLinear 后单次查找耗时与输入长度成线性关系，
+     * ExtractAll 等遍历所有匹配的函数最坏为平方复杂度（见 LinearRegex）；
+     * 模式中出现不支持的语法（反向引用、环视）时会按编译失败处理；
+     * 被量词修饰且可匹配空串的分组上，匹配结果可能与 kStd 不同（见 LinearRegex）。
+     *
+     * @param engine 正则引擎
+     */
+    static void SetRegexEngine( RegexEngine engine );
+    /// 当前 Extract* 函数使用的默认引擎
+    static RegexEngine GetRegexEngine();
     /**
      * @brief 在字符串左侧填充字符至指定长度
      * @param str 原字符串
@@ -909,6 +2073,59 @@ public:
     [[nodiscard]] static std::string RandomString(
         size_t           length,
         std::string_view charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789" ) noexcept;
+    /**
+     * @brief 生成随机字符串并写入调用方提供的缓冲区 [first, last)，不分配内存
+     *
+     * 使用每线程一个的 xoshiro256** 发生器（非密码学安全）。字符集大小为2的幂时按位掩码取字符，
+     * 每次64位抽样产出多个字符；否则按字节拒绝采样，保证各字符等概率。
+     *
+     * @param first 缓冲区起点
+     * @param last 缓冲区终点
+     * @param charset 字符集
+     * @return 写入内容的末尾；字符集为空时不写入，返回 first
+     *
+     * @code{.cpp}
+     *   char name[12];
+     *   RandomStringTo( name, name + sizeof( name ), "0123456789abcdef" );
+     * @endcode
+     */
+    static char *RandomStringTo(
+        char *first, char *last,
+        std::string_view charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789" ) noexcept;
+    /// UUID 文本长度（8-4-4-4-12 格式，不含结束符）
+    static constexpr size_t kUuidLength = 36;
+    /**
+     * @brief 生成随机 UUID（RFC 9562 版本4），小写十六进制
+     * @return std::string 例如 "3f2b8c1e-9a4d-4e6f-b2c1-7d8e9f0a1b2c"
+     */
+    [[nodiscard]] static std::string UuidV4() noexcept;
+    /**
+     * @brief 生成随机 UUID（版本4）并写入调用方缓冲区，不分配内存
+     * @param first 缓冲区起点
+     * @param last 缓冲区终点
+     * @return 写入内容的末尾（不写入结束符）；缓冲区不足 kUuidLength 时返回 nullptr
+     *
+     * @code{.cpp}
+     *   char id[StringUtil::kUuidLength];
+     *   StringUtil::UuidV4To( id, id + sizeof( id ) );
+     * @endcode
+     */
+    static char *UuidV4To( char *first, char *last ) noexcept;
+    /**
+     * @brief 生成按时间排序的 UUID（RFC 9562 版本7）：48位毫秒时间戳 + 12位计数器 + 62位随机数
+     *
+     * 同一线程生成的 UUID 按字典序严格递增，适合作为数据库主键或请求ID。
+     *
+     * @return std::string
+     */
+    [[nodiscard]] static std::string UuidV7() noexcept;
+    /**
+     * @brief 生成版本7 UUID 并写入调用方缓冲区，不分配内存
+     * @param first 缓冲区起点
+     * @param last 缓冲区终点
+     * @return 写入内容的末尾（不写入结束符）；缓冲区不足 kUuidLength 时返回 nullptr
+     */
+    static char *UuidV7To( char *first, char *last ) noexcept;
     /**
      * @brief 检查字符串是否为数字
      * @param str 输入字符串
@@ -1007,6 +2224,9 @@ public:
     [[nodiscard]] static std::string SnakeToCamel( std::string_view str, bool upper_first = false ) noexcept;
 
 private:
+    /// FromNumber 使用的栈缓冲区大小，足以容纳任何整数及浮点数的最短表示
+    static constexpr size_t kNumberBufferSize = 128;
+
     /// 清除错误输出缓冲区
     static void ClearError( std::string *error_msg ) noexcept;
     /// 设置错误信息（内部工具，支持变参拼接）
@@ -1019,6 +2239,100 @@ private:
     }
     /// 检测整数进制：支持 0x（16进制）、0（8进制）、其余为10进制
     static int DetectBase( std::string_view str ) noexcept;
+    /**
+     * @brief 解析连续的十进制数字，每次用SWAR处理8位
+     * @param value [out] 数值，溢出时无意义
+     * @param overflow [out] 是否超出 uint64_t 范围
+     * @return 第一个非数字字符的位置
+     */
+    static const char *ParseDecimalDigits( const char *begin, const char *end, uint64_t &value,
+                                           bool &overflow ) noexcept;
+    /// 解析 ParseNumbers 的单个字段，失败时 error_at 指向出错位置
+    template <typename T>
+    static std::errc ParseNumberField( std::string_view field, T &value, const char *&error_at ) noexcept {
+        const char *begin = field.data();
+        const char *end   = begin + field.size();
+        error_at          = begin;
+        if ( field.empty() ) {
+            return std::errc::invalid_argument;
+        }
+        if constexpr ( std::is_floating_point_v<T> ) {
+            // from_chars 不接受 '+' 号
+            if ( *begin == '+' && field.size() > 1 && begin[1] != '-' ) {
+                ++begin;
+            }
+            const auto [ptr, ec] = std::from_chars( begin, end, value );
+            if ( ec == std::errc::invalid_argument || ptr != end ) {
+                error_at = ec == std::errc::invalid_argument ? begin : ptr;
+                return std::errc::invalid_argument;
+            }
+            return ec;
+        }
+        else {
+            const bool negative = *begin == '-';
+            if ( negative || *begin == '+' ) {
+                ++begin;
+            }
+            uint64_t    magnitude = 0;
+            bool        overflow  = false;
+            const char *stop      = ParseDecimalDigits( begin, end, magnitude, overflow );
+            if ( stop == begin || stop != end || ( negative && std::is_unsigned_v<T> ) ) {
+                error_at = stop == begin || stop != end ? stop : field.data();
+                return std::errc::invalid_argument;
+            }
+            // 负数的绝对值上限比正数多1
+            const uint64_t limit = static_cast<uint64_t>( std::numeric_limits<T>::max() ) + ( negative ? 1 : 0 );
+            if ( overflow || magnitude > limit ) {
+                return std::errc::result_out_of_range;
+            }
+            value = negative ? static_cast<T>( 0 - magnitude ) : static_cast<T>( magnitude );
+            return std::errc{};
+        }
+    }
+};
+
+/**
+ * @brief 字符串哈希函数对象，基于 StringUtil::Hash，可直接接受 std::string、string_view 和 C 字符串
+ *
+ * 声明了 is_transparent：C++20 起配合 StringEqual 可在 unordered_map<std::string, ...> 上直接以
+ * string_view 查找而不构造临时 std::string；C++17 下可用于以 string_view 为键的容器（如 StringPool 的内部索引）。
+ *
+ * @code{.cpp}
+ *   std::unordered_map<std::string, int, StringHash, StringEqual> counts;
+ *   for ( auto field : StringUtil::SplitRef( line, "," ) ) {
+ *       ++counts[std::string( field )];
+ *   }
+ * @endcode
+ */
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()( std::string_view str ) const noexcept { return static_cast<size_t>( StringUtil::Hash( str ) ); }
+};
+
+/// 与 StringHash 配套的透明相等比较
+struct StringEqual {
+    using is_transparent = void;
+
+    bool operator()( std::string_view lhs, std::string_view rhs ) const noexcept { return lhs == rhs; }
+};
+
+/// 忽略ASCII大小写的字符串哈希函数对象，需与 StringEqualIgnoreCase 配套使用
+struct StringHashIgnoreCase {
+    using is_transparent = void;
+
+    size_t operator()( std::string_view str ) const noexcept {
+        return static_cast<size_t>( StringUtil::HashIgnoreCase( str ) );
+    }
+};
+
+/// 忽略ASCII大小写的透明相等比较
+struct StringEqualIgnoreCase {
+    using is_transparent = void;
+
+    bool operator()( std::string_view lhs, std::string_view rhs ) const noexcept {
+        return StringUtil::EqualsIgnoreCase( lhs, rhs );
+    }
 };
 
 /**
@@ -1041,6 +2355,24 @@ public:
      */
     explicit StringFormatter( std::string_view format ) : format_( format ) {}
 
+    class Template;
+    /**
+     * @brief 预编译格式字符串，得到可重复渲染的不可变模板
+     *
+     * 占位符规则与 Args 相同：%1, %2, ... 取最长的数字序列作为序号，%0 及以 0 开头的序号视为普通文本。
+     * 模板只解析一次，之后每次 Render 都一次性分配结果并顺序写入；模板可以在多个线程间共享。
+     *
+     * @param format 格式化字符串
+     * @return 编译后的模板
+     *
+     * @code{.cpp}
+     *   static const auto kAccessLog = StringFormatter::Compile( "%1 %2 -> %3 (%4 ms)" );
+     *   std::string line = kAccessLog.Render( "GET", "/index.html", 200, 1.25 );
+     *   // line = "GET /index.html -> 200 (1.25 ms)"
+     * @endcode
+     */
+    [[nodiscard]] static Template Compile( std::string_view format );
+
     /**
      * @brief 添加格式化参数，支持可变参数模板
      *
@@ -1132,9 +2464,11 @@ private:
             return std::to_string( value );
         }
         else if constexpr ( std::is_floating_point_v<Decayed> ) {
-            std::ostringstream oss;
-            oss << std::defaultfloat << std::setprecision( 6 ) << value;
-            return oss.str();
+            // 与 std::defaultfloat 默认精度的输出相同（%g）
+            char       buffer[64];
+            const auto result =
+                std::to_chars( buffer, buffer + sizeof( buffer ), value, std::chars_format::general, 6 );
+            return std::string( buffer, static_cast<size_t>( result.ptr - buffer ) );
         }
         else if constexpr ( std::is_convertible_v<Decayed, std::string_view> ) {
             return std::string{ std::string_view{ value } };
@@ -1151,10 +2485,102 @@ private:
     // 特化浮点型转换函数
     template <typename FloatType>
     static std::string ConvertFloatToString( FloatType value, int precision ) {
-        std::ostringstream oss;
-        oss << std::fixed << std::setprecision( precision ) << value;
-        return oss.str();
+        // 负精度与 std::setprecision 一致，按默认的6位处理
+        return StringUtil::FromNumber( value, 10, precision < 0 ? 6 : precision );
+    }
+};
+
+/**
+ * @brief StringFormatter::Compile 生成的格式模板，由文本片段和参数槽组成
+ *
+ * 参数转换规则与 StringFormatter::Args 相同：布尔值为 true/false，浮点数使用 %g 格式，
+ * 字符串参数直接引用不做拷贝。参数少于占位符序号时，对应占位符原样保留。
+ * 与 Args 逐个替换不同，参数内容中出现的 "%N" 不会被再次替换。
+ */
+class StringFormatter::Template {
+public:
+    Template() = default;
+
+    /// 格式字符串中引用的最大参数序号，没有占位符时为0
+    [[nodiscard]] size_t MaxArgIndex() const noexcept { return max_arg_index_; }
+
+    /**
+     * @brief 渲染模板
+     * @param args 参数列表，第 N 个参数替换 %N
+     * @return 渲染结果
+     */
+    template <typename... TArgs>
+    [[nodiscard]] std::string Render( const TArgs &...args ) const {
+        std::string result;
+        RenderTo( result, args... );
+        return result;
+    }
+
+    /**
+     * @brief 渲染模板并追加到out末尾
+     * @param out [out] 输出缓冲区
+     * @param args 参数列表，第 N 个参数替换 %N
+     */
+    template <typename... TArgs>
+    void RenderTo( std::string &out, const TArgs &...args ) const {
+        if constexpr ( sizeof...( args ) == 0 ) {
+            Append( out, nullptr, 0 );
+        }
+        else {
+            const ArgText texts[] = { ArgText( args )... };
+            Append( out, texts, sizeof...( args ) );
+        }
     }
+
+private:
+    friend class StringFormatter;
+
+    /// 一段文本及其后的参数槽，文本和占位符都以偏移引用 format_
+    struct Piece {
+        size_t literal_begin;
+        size_t literal_length;
+        size_t arg_index;           ///< 参数序号，0 表示没有参数槽
+        size_t placeholder_length;  ///< 占位符 "%N" 的长度
+    };
+
+    /// 单个参数的文本形式，数值格式化到内部缓冲区，字符串直接引用
+    class ArgText {
+    public:
+        template <typename T>
+        explicit ArgText( const T &value ) noexcept {
+            if constexpr ( std::is_same_v<T, bool> ) {
+                view_ = value ? "true" : "false";
+            }
+            else if constexpr ( std::is_integral_v<T> ) {
+                const auto result = std::to_chars( buffer_, buffer_ + sizeof( buffer_ ), value );
+                view_             = std::string_view( buffer_, static_cast<size_t>( result.ptr - buffer_ ) );
+            }
+            else if constexpr ( std::is_floating_point_v<T> ) {
+                const auto result =
+                    std::to_chars( buffer_, buffer_ + sizeof( buffer_ ), value, std::chars_format::general, 6 );
+                view_ = std::string_view( buffer_, static_cast<size_t>( result.ptr - buffer_ ) );
+            }
+            else {
+                static_assert( std::is_convertible_v<T, std::string_view>, "Unsupported type for string formatting" );
+                view_ = std::string_view( value );
+            }
+        }
+        ArgText( const ArgText & )            = delete;
+        ArgText &operator=( const ArgText & ) = delete;
+
+        [[nodiscard]] std::string_view View() const noexcept { return view_; }
+
+    private:
+        char             buffer_[64];
+        std::string_view view_;
+    };
+
+    /// 计算结果长度，一次扩容后顺序写入
+    void Append( std::string &out, const ArgText *args, size_t arg_count ) const;
+
+    std::string        format_;
+    std::vector<Piece> pieces_;
+    size_t             max_arg_index_ = 0;
 };
 
 }  // namespace utils
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include <string>
+#include <vector>
+#include "AhoCorasick.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::vector<std::string> CollectMatches( const utils::AhoCorasick &ac, std::string_view text ) {
+    std::vector<std::string> result;
+    ac.ForEachMatch( text, [&]( const utils::AhoCorasick::Match &match ) {
+        result.emplace_back( text.substr( match.offset, match.length ) );
+    } );
+    return result;
+}
+
+}  // namespace
+
+TEST( AhoCorasickTest, FindNext ) {
+    utils::AhoCorasick ac{ "he", "she", "his", "hers" };
+    EXPECT_EQ( ac.PatternCount(), 4 );
+    EXPECT_EQ( ac.MaxPatternLength(), 4 );
+
+    auto match = ac.FindNext( "ushers" );
+    ASSERT_TRUE( match.has_value() );
+    EXPECT_EQ( match->pattern, 1 );
+    EXPECT_EQ( match->offset, 1 );
+    EXPECT_EQ( match->length, 3 );
+
+    // 从指定位置开始查找
+    match = ac.FindNext( "ushers", 2 );
+    ASSERT_TRUE( match.has_value() );
+    EXPECT_EQ( match->pattern, 3 );
+    EXPECT_EQ( match->offset, 2 );
+
+    EXPECT_FALSE( ac.FindNext( "xyz" ).has_value() );
+    EXPECT_FALSE( ac.FindNext( "" ).has_value() );
+    EXPECT_FALSE( ac.FindNext( "he", 5 ).has_value() );
+}
+
+TEST( AhoCorasickTest, LeftmostLongest ) {
+    // 起点更靠左的匹配优先，即使它更晚结束
+    utils::AhoCorasick ac{ "bc", "abcd" };
+    EXPECT_EQ( CollectMatches( ac, "abcd" ), std::vector<std::string>{ "abcd" } );
+    EXPECT_EQ( CollectMatches( ac, "abce" ), std::vector<std::string>{ "bc" } );
+
+    // 同起点取最长
+    utils::AhoCorasick prefixes{ "a", "ab", "abc" };
+    EXPECT_EQ( CollectMatches( prefixes, "abcab" ), ( std::vector<std::string>{ "abc", "ab" } ) );
+
+    // 匹配不重叠
+    utils::AhoCorasick overlap{ "aa" };
+    EXPECT_EQ( CollectMatches( overlap, "aaaaa" ), ( std::vector<std::string>{ "aa", "aa" } ) );
+}
+
+TEST( AhoCorasickTest, EdgeCases ) {
+    // 空模式串被忽略，重复模式串以第一次为准
+    std::vector<std::string> patterns{ "", "foo", "foo" };
+    utils::AhoCorasick       ac( patterns );
+    EXPECT_EQ( ac.PatternCount(), 3 );
+    auto match = ac.FindNext( "xfoo" );
+    ASSERT_TRUE( match.has_value() );
+    EXPECT_EQ( match->pattern, 1 );
+
+    // 没有模式串
+    utils::AhoCorasick empty;
+    EXPECT_FALSE( empty.FindNext( "anything" ).has_value() );
+
+    // 高位字节
+    utils::AhoCorasick binary{ std::string_view( "\xFF\x00", 2 ) };
+    match = binary.FindNext( std::string_view( "a\xFF\x00z", 4 ) );
+    ASSERT_TRUE( match.has_value() );
+    EXPECT_EQ( match->offset, 1 );
+
+    // 回调返回false时停止
+    utils::AhoCorasick digits{ "1", "2", "3" };
+    size_t             count = 0;
+    digits.ForEachMatch( "123", [&]( const utils::AhoCorasick::Match & ) {
+        ++count;
+        return false;
+    } );
+    EXPECT_EQ( count, 1 );
+}
+
+TEST( AhoCorasickTest, ForEachMatchAgreesWithFindNext ) {
+    uint32_t seed = 12345;
+    auto     rand = [&] { return seed = seed * 1103515245 + 12345, ( seed >> 16 ) & 0x7FFF; };
+    for ( int round = 0; round < 50; ++round ) {
+        std::vector<std::string> patterns( 1 + rand() % 8 );
+        for ( auto &pattern : patterns ) {
+            for ( size_t len = rand() % 6; pattern.size() < len; ) {
+                pattern.push_back( static_cast<char>( 'a' + rand() % 3 ) );
+            }
+        }
+        // 文本跨越多个扫描块，覆盖跨块的匹配
+        std::string text( 5000 + rand() % 5000, 'a' );
+        for ( auto &c : text ) {
+            c = static_cast<char>( 'a' + rand() % 3 );
+        }
+
+        utils::AhoCorasick                     ac( patterns );
+        std::vector<utils::AhoCorasick::Match> expected;
+        size_t                                 pos = 0;
+        while ( auto match = ac.FindNext( text, pos ) ) {
+            expected.push_back( *match );
+            pos = match->offset + match->length;
+        }
+        std::vector<utils::AhoCorasick::Match> actual;
+        ac.ForEachMatch( text, [&]( const utils::AhoCorasick::Match &match ) { actual.push_back( match ); } );
+        ASSERT_EQ( actual.size(), expected.size() );
+        for ( size_t i = 0; i < actual.size(); ++i ) {
+            EXPECT_EQ( actual[i].pattern, expected[i].pattern );
+            EXPECT_EQ( actual[i].offset, expected[i].offset );
+            EXPECT_EQ( actual[i].length, expected[i].length );
+        }
+    }
+}
+
+TEST( AhoCorasickTest, LongPatternLookahead ) {
+    // 每个短匹配都要预读长模式串才能确认，逐次重新扫描预读部分时是 O(n·m)
+    const std::string long_pattern = std::string( 4000, 'a' ) + "b";
+    utils::AhoCorasick ac{ "a", long_pattern };
+    const std::string  text( 1 << 20, 'a' );
+    size_t             count = 0;
+    ac.ForEachMatch( text, [&]( const utils::AhoCorasick::Match &match ) {
+        EXPECT_EQ( match.pattern, 0 );
+        ++count;
+    } );
+    EXPECT_EQ( count, text.size() );
+
+    // 长模式串跨越扫描块时仍取最长
+    const std::string mixed = std::string( 4090, 'x' ) + long_pattern + "a";
+    EXPECT_EQ( CollectMatches( ac, mixed ), ( std::vector<std::string>{ long_pattern, "a" } ) );
+}
@@ -0,0 +1,103 @@
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "StringUtil.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+/// 当前线程的堆分配次数，用于验证热路径不分配内存
+thread_local size_t g_allocations = 0;
+
+}  // namespace
+
+void *operator new( std::size_t size ) {
+    ++g_allocations;
+    if ( void *ptr = std::malloc( size == 0 ? 1 : size ) ) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete( void *ptr ) noexcept {
+    std::free( ptr );
+}
+
+void operator delete( void *ptr, std::size_t ) noexcept {
+    std::free( ptr );
+}
+
+TEST( AllocationTest, ToNumberDoesNotAllocate ) {
+    // 输入包含超过短字符串优化长度的空白，旧实现的 Trim 会为其分配内存
+    const std::string int_field    = "   \t  123456789  \t\r\n         ";
+    const std::string hex_field    = "                 0x7FFFFFFF    ";
+    const std::string double_field = "               -1234.5e-3      ";
+    const std::string bad_field    = "               12ab            ";
+
+    const size_t before = g_allocations;
+    int64_t      sum    = 0;
+    double       total  = 0;
+    for ( int i = 0; i < 1000; ++i ) {
+        sum += *utils::StringUtil::ToNumber<int64_t>( int_field );
+        sum += *utils::StringUtil::ToNumber<int32_t>( hex_field );
+        total += *utils::StringUtil::ToNumber<double>( double_field );
+        sum += utils::StringUtil::ToNumber<int>( bad_field ).value_or( 0 );
+        sum += utils::StringUtil::TrimRef( int_field ).size();
+    }
+    EXPECT_EQ( g_allocations, before );
+    EXPECT_EQ( sum, 1000 * ( 123456789LL + 0x7FFFFFFF + 9 ) );
+    EXPECT_NEAR( total, 1000 * -1.2345, 1e-6 );
+}
+
+TEST( AllocationTest, FormatNumberToDoesNotAllocate ) {
+    char         buffer[64];
+    size_t       total  = 0;
+    const size_t before = g_allocations;
+    for ( int i = 0; i < 1000; ++i ) {
+        total += utils::StringUtil::FormatNumberTo( buffer, buffer + sizeof( buffer ), i * 0.001 ) - buffer;
+        total += utils::StringUtil::FormatNumberTo( buffer, buffer + sizeof( buffer ), i * 1.5, 10, 2 ) - buffer;
+        total += utils::StringUtil::FormatNumberTo( buffer, buffer + sizeof( buffer ), i * 7919 ) - buffer;
+    }
+    EXPECT_EQ( g_allocations, before );
+    EXPECT_GT( total, 0 );
+}
+
+TEST( AllocationTest, BuildersAllocateAtMostOnce ) {
+    const std::string              long_part( 100, 'x' );
+    const std::vector<std::string> parts{ long_part, long_part, long_part, long_part };
+    const char                    *name = "a fairly long name that does not fit into the small string buffer";
+
+    auto count = [&]( auto &&fn ) {
+        const size_t before = g_allocations;
+        auto         result = fn();
+        const size_t used   = g_allocations - before;
+        EXPECT_FALSE( result.empty() );
+        return used;
+    };
+    EXPECT_LE( count( [&] { return utils::StringUtil::Join( "/", long_part, "b", std::string_view( long_part ) ); } ),
+               1 );
+    EXPECT_LE( count( [&] { return utils::StringUtil::Join( "/", long_part, long_part, long_part ); } ), 1 );
+    EXPECT_LE( count( [&] { return utils::StringUtil::Join( parts, ", " ); } ), 1 );
+    EXPECT_LE( count( [&] { return utils::StringUtil::Repeat( "abc", 10 ); } ), 1 );
+    EXPECT_LE( count( [&] { return utils::StringUtil::Repeat( "abc", 1000 ); } ), 1 );
+    EXPECT_LE( count( [&] { return utils::StringUtil::FormatCString( "%s = %d", name, 42 ); } ), 1 );
+    EXPECT_LE( count( [&] {
+                   return utils::StringUtil::FormatCString( "%s %s %s %s %s", name, name, name, name, name );
+               } ),
+               1 );
+}
+
+TEST( AllocationTest, RandomIdsDoNotAllocate ) {
+    char         name[24];
+    char         uuid[utils::StringUtil::kUuidLength];
+    size_t       total  = 0;
+    const size_t before = g_allocations;
+    for ( int i = 0; i < 1000; ++i ) {
+        total += utils::StringUtil::RandomStringTo( name, name + sizeof( name ) ) - name;
+        total += utils::StringUtil::UuidV4To( uuid, uuid + sizeof( uuid ) ) - uuid;
+        total += utils::StringUtil::UuidV7To( uuid, uuid + sizeof( uuid ) ) - uuid;
+    }
+    EXPECT_EQ( g_allocations, before );
+    EXPECT_EQ( total, 1000 * ( sizeof( name ) + 2 * sizeof( uuid ) ) );
+}
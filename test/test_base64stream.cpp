@@ -0,0 +1,46 @@
+#include <string>
+#include "Base64Stream.h"
+#include "StringUtil.h"
+#include "gtest/gtest.h"
+
+TEST( Base64StreamTest, MatchesBase64Encode ) {
+    std::string data;
+    for ( int i = 0; i < 1000; ++i ) {
+        data += static_cast<char>( i * 31 + 7 );
+    }
+    for ( auto alphabet : { utils::Base64Alphabet::kStandard, utils::Base64Alphabet::kUrlSafe } ) {
+        for ( bool padding : { true, false } ) {
+            for ( size_t size : { 0, 1, 2, 3, 100, 1000 } ) {
+                const std::string_view input( data.data(), size );
+                const std::string      expected = utils::StringUtil::Base64Encode( input, alphabet, padding );
+                for ( size_t chunk_size : { 1, 2, 4, 5, 64, 1000 } ) {
+                    SCOPED_TRACE( std::to_string( size ) + " / chunk " + std::to_string( chunk_size ) );
+                    utils::Base64StreamEncoder encoder( alphabet, padding );
+                    std::string                out;
+                    for ( size_t pos = 0; pos < input.size(); pos += chunk_size ) {
+                        encoder.Update( input.substr( pos, chunk_size ), out );
+                        // 每次只输出完整的组
+                        EXPECT_EQ( out.size() % 4, 0 );
+                    }
+                    encoder.Finish( out );
+                    EXPECT_EQ( out, expected );
+                    EXPECT_EQ( encoder.Consumed(), size );
+                }
+            }
+        }
+    }
+}
+
+TEST( Base64StreamTest, ReuseAfterFinish ) {
+    utils::Base64StreamEncoder encoder;
+    std::string                out;
+    encoder.Update( "he", out );
+    encoder.Update( "llo", out );
+    encoder.Finish( out );
+    EXPECT_EQ( out, "aGVsbG8=" );
+
+    out.clear();
+    encoder.Update( "a", out );
+    encoder.Finish( out );
+    EXPECT_EQ( out, "YQ==" );
+}
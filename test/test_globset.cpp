@@ -0,0 +1,143 @@
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "GlobSet.h"
+#include "gtest/gtest.h"
+
+TEST( GlobSetTest, Match ) {
+    utils::GlobSet globs;
+    EXPECT_TRUE( globs.Empty() );
+
+    const auto exact     = globs.Add( "api/health" );
+    const auto prefix    = globs.Add( "api/*" );
+    const auto suffix    = globs.Add( "*.log" );
+    const auto substring = globs.Add( "*error*" );
+    const auto question  = globs.Add( "?pi/h*" );
+    const auto any       = globs.Add( "*" );
+    EXPECT_EQ( globs.Size(), 6 );
+
+    EXPECT_EQ( globs.Match( "api/health" ), ( std::vector<size_t>{ exact, prefix, question, any } ) );
+    EXPECT_EQ( globs.Match( "api/error.log" ), ( std::vector<size_t>{ prefix, suffix, substring, any } ) );
+    EXPECT_EQ( globs.Match( "error error" ), ( std::vector<size_t>{ substring, any } ) );
+    EXPECT_EQ( globs.Match( "" ), ( std::vector<size_t>{ any } ) );
+    EXPECT_TRUE( globs.MatchAny( "xyz" ) );
+
+    // 写入复用的缓冲区
+    std::vector<size_t> ids{ 42 };
+    globs.Match( "x.log", ids );
+    EXPECT_EQ( ids, ( std::vector<size_t>{ suffix, any } ) );
+}
+
+TEST( GlobSetTest, MoveOutlivesSource ) {
+    // 索引键引用模式字符串，禁止复制；移动后销毁源对象，查找仍引用有效内存
+    static_assert( !std::is_copy_constructible_v<utils::GlobSet> );
+    static_assert( !std::is_copy_assignable_v<utils::GlobSet> );
+
+    auto       source = std::make_unique<utils::GlobSet>();
+    const auto exact  = source->Add( "some-fairly-long-exact-name-beyond-sso" );
+    const auto middle = source->Add( "*fairly-long-substring*" );
+    const auto prefix = source->Add( "some-fairly-long-prefix-*" );
+
+    utils::GlobSet moved( std::move( *source ) );
+    source.reset();
+    EXPECT_EQ( moved.Match( "some-fairly-long-exact-name-beyond-sso" ), ( std::vector<size_t>{ exact } ) );
+    EXPECT_EQ( moved.Match( "a fairly-long-substring b" ), ( std::vector<size_t>{ middle } ) );
+
+    auto assigned = std::make_unique<utils::GlobSet>();
+    *assigned     = std::move( moved );
+    EXPECT_EQ( assigned->Match( "some-fairly-long-prefix-x" ), ( std::vector<size_t>{ prefix } ) );
+    EXPECT_TRUE( assigned->Remove( exact ) );
+    EXPECT_FALSE( assigned->MatchAny( "some-fairly-long-exact-name-beyond-sso" ) );
+}
+
+TEST( GlobSetTest, AddRemove ) {
+    utils::GlobSet globs;
+    const auto     a = globs.Add( "*.txt" );
+    const auto     b = globs.Add( "*.txt" );
+    const auto     c = globs.Add( "*mid*" );
+    EXPECT_NE( a, b );
+
+    EXPECT_EQ( globs.Match( "a.txt" ), ( std::vector<size_t>{ a, b } ) );
+    EXPECT_TRUE( globs.Remove( a ) );
+    EXPECT_FALSE( globs.Remove( a ) );
+    EXPECT_EQ( globs.Match( "a.txt" ), ( std::vector<size_t>{ b } ) );
+
+    EXPECT_TRUE( globs.Remove( c ) );
+    EXPECT_FALSE( globs.MatchAny( "amidb" ) );
+
+    // 删除后重新添加得到新编号
+    const auto d = globs.Add( "*mid*" );
+    EXPECT_GT( d, c );
+    EXPECT_EQ( globs.Match( "amidb" ), ( std::vector<size_t>{ d } ) );
+
+    globs.Clear();
+    EXPECT_TRUE( globs.Empty() );
+    EXPECT_TRUE( globs.Match( "a.txt" ).empty() );
+}
+
+TEST( GlobSetTest, RemoveDuplicateKeepsIndex ) {
+    // 精确索引和子串索引的键引用第一个模式的字符串，删除它后剩余的重复模式必须仍可查找
+    for ( const char *pattern : { "exact.txt", "*needle*" } ) {
+        utils::GlobSet globs;
+        const auto     first  = globs.Add( pattern );
+        const auto     second = globs.Add( pattern );
+        EXPECT_TRUE( globs.Remove( first ) );
+        for ( int i = 0; i < 100; ++i ) {
+            globs.Add( "filler" + std::to_string( i ) );
+            globs.Add( "*fill" + std::to_string( i ) + "*" );
+        }
+        const std::string input = std::string( pattern ) == "exact.txt" ? "exact.txt" : "a needle here";
+        EXPECT_EQ( globs.Match( input ), ( std::vector<size_t>{ second } ) ) << pattern;
+        EXPECT_TRUE( globs.Remove( second ) );
+        EXPECT_FALSE( globs.MatchAny( input ) ) << pattern;
+    }
+}
+
+TEST( GlobSetTest, ChurnReclaimsTrieNodes ) {
+    // 反复添加、删除不同前缀和后缀的模式，字典树节点数不随轮数增长
+    utils::GlobSet globs;
+    const auto     keep = globs.Add( "tenant-*" );
+    const size_t   base = globs.TrieNodeCount();
+    for ( int i = 0; i < 20000; ++i ) {
+        const auto prefix = globs.Add( "tenant-" + std::to_string( i ) + "-*" );
+        const auto suffix = globs.Add( "*." + std::to_string( i ) + ".log" );
+        EXPECT_EQ( globs.Match( "tenant-" + std::to_string( i ) + "-a." + std::to_string( i ) + ".log" ),
+                   ( std::vector<size_t>{ keep, prefix, suffix } ) );
+        EXPECT_TRUE( globs.Remove( prefix ) );
+        EXPECT_TRUE( globs.Remove( suffix ) );
+    }
+    EXPECT_EQ( globs.Size(), 1 );
+    EXPECT_EQ( globs.TrieNodeCount(), base );
+    EXPECT_EQ( globs.Match( "tenant-1-x" ), ( std::vector<size_t>{ keep } ) );
+
+    // 删除共享前缀的模式时只回收它独有的节点
+    const auto longer = globs.Add( "tenant-abc*" );
+    EXPECT_TRUE( globs.Remove( keep ) );
+    EXPECT_EQ( globs.Match( "tenant-abcd" ), ( std::vector<size_t>{ longer } ) );
+    EXPECT_TRUE( globs.Remove( longer ) );
+    EXPECT_EQ( globs.TrieNodeCount(), 2 );
+}
+
+TEST( GlobSetTest, ConsistentWithWildcardMatch ) {
+    // 与逐个调用WildcardMatch结果一致
+    const std::vector<std::string> patterns{ "*",      "a*", "*a",  "*ab*", "a?b",          "??",  "a*b*c",
+                                             "*b?c*",  "abcabc", "*c", "?*?", "*abcdefghij*", "b*", "*a*b*" };
+    const std::vector<std::string> inputs{ "",    "a",      "ab",  "abc",    "aXb",          "abcabc",
+                                           "cba", "xxabyy", "bac", "aabbcc", "xabcdefghijk", "b" };
+
+    utils::GlobSet globs;
+    for ( const auto &pattern : patterns ) {
+        globs.Add( pattern );
+    }
+    for ( const auto &input : inputs ) {
+        std::vector<size_t> expected;
+        for ( size_t i = 0; i < patterns.size(); ++i ) {
+            if ( utils::StringUtil::WildcardMatch( input, patterns[i] ) ) {
+                expected.push_back( i );
+            }
+        }
+        EXPECT_EQ( globs.Match( input ), expected ) << "input=" << input;
+        EXPECT_EQ( globs.MatchAny( input ), !expected.empty() ) << "input=" << input;
+    }
+}
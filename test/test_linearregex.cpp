@@ -0,0 +1,237 @@
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LinearRegex.h"
+#include "StringUtil.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+/// 用 std::regex_iterator 的结果作为基准，逐个比较所有匹配的每个捕获组
+void ExpectSameAsStd( const std::string &pattern, const std::string &text ) {
+    SCOPED_TRACE( "pattern: " + pattern + ", text: " + text );
+    auto linear = utils::LinearRegex::Compile( pattern );
+    ASSERT_NE( linear, nullptr );
+
+    const std::regex         re( pattern );
+    std::vector<std::string> expected;
+    for ( auto iter = std::sregex_iterator( text.begin(), text.end(), re ); iter != std::sregex_iterator(); ++iter ) {
+        for ( size_t g = 0; g < iter->size(); ++g ) {
+            expected.push_back( ( *iter )[g].matched ? ( *iter )[g].str() : "<unmatched>" );
+        }
+    }
+
+    std::vector<std::string>              actual;
+    std::vector<utils::LinearRegex::Span> groups;
+    size_t                                pos       = 0;
+    bool                                  not_empty = false;
+    while ( pos <= text.size() && linear->Search( text, pos, groups, not_empty ) ) {
+        for ( const auto &span : groups ) {
+            actual.push_back( span.Matched() ? text.substr( span.begin, span.end - span.begin ) : "<unmatched>" );
+        }
+        pos       = groups[0].end;
+        not_empty = groups[0].end == groups[0].begin;
+    }
+    EXPECT_EQ( actual, expected );
+}
+
+}  // namespace
+
+TEST( LinearRegexTest, MatchesStdRegex ) {
+    const std::vector<std::string> patterns = {
+        R"(\d+)",
+        R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})",
+        R"((\d{4})-(\d{2})-(\d{2}))",
+        R"(\b\w{4}\b)",
+        R"(\Bo\B)",
+        R"(^\w+)",
+        R"(\w+$)",
+        R"(a|ab|abc)",
+        R"((a|ab)(c|bcd)(d*))",
+        R"((a+)(a*))",
+        R"((a+?)(a*))",
+        R"(a{2,3})",
+        R"(a{2,3}?)",
+        R"(a{2,})",
+        R"((?:ab)+)",
+        R"((a)|(b))",
+        R"(x*)",
+        R"([^aeiou\s]+)",
+        R"([\d-]+)",
+        R"([]a])",
+        R"(.+)",
+        R"(\x41\.)",
+        R"re((\w+)\s*=\s*"([^"]*)")re",
+        R"(((a)|b)+)",
+        R"(a*|b)",
+        R"((?:)|\w+)",
+        R"(\b|o)",
+    };
+    const std::vector<std::string> texts = {
+        "",
+        "abc123def456",
+        "email: test@example.com, other@foo.org",
+        "Date: 2023-12-25, Date: 2024-01-01",
+        "the quick brown fox jumps over the lazy dog",
+        "aaaa",
+        "abcd abcbcd ab",
+        "line1\nline2\r\nend",
+        "A. A! a.",
+        R"(key = "value", other="x")",
+        "abab aba b ba",
+        "b",
+    };
+    for ( const auto &pattern : patterns ) {
+        for ( const auto &text : texts ) {
+            ExpectSameAsStd( pattern, text );
+        }
+    }
+}
+
+TEST( LinearRegexTest, CompileErrors ) {
+    std::string error_msg;
+    for ( const char *pattern : { "(", "a)", "[a", "*a", "a**", "\\", "(a)\\1", "(?=a)", "a{3,2}", "[z-a]", "\\q",
+                                  "^*", "a{1001}" } ) {
+        SCOPED_TRACE( pattern );
+        error_msg.clear();
+        EXPECT_EQ( utils::LinearRegex::Compile( pattern, &error_msg ), nullptr );
+        EXPECT_FALSE( error_msg.empty() );
+    }
+    // 分组嵌套过深时报错而不是栈溢出
+    const std::string deep = std::string( 100000, '(' ) + "a" + std::string( 100000, ')' );
+    error_msg.clear();
+    EXPECT_EQ( utils::LinearRegex::Compile( deep, &error_msg ), nullptr );
+    EXPECT_FALSE( error_msg.empty() );
+    EXPECT_NE( utils::LinearRegex::Compile( std::string( 100, '(' ) + "a" + std::string( 100, ')' ) ), nullptr );
+
+    // 不构成量词的花括号按字面量处理
+    auto brace = utils::LinearRegex::Compile( "a{,2}" );
+    ASSERT_NE( brace, nullptr );
+    std::vector<utils::LinearRegex::Span> groups;
+    EXPECT_TRUE( brace->Search( "xa{,2}", 0, groups ) );
+    EXPECT_EQ( groups[0].begin, 1 );
+    EXPECT_EQ( groups[0].end, 6 );
+}
+
+TEST( LinearRegexTest, PathologicalInput ) {
+    // 回溯引擎在这类模式上是指数级的
+    auto        regex = utils::LinearRegex::Compile( "(a*)*(a|b)*c" );
+    std::string text( 20000, 'a' );
+    ASSERT_NE( regex, nullptr );
+    std::vector<utils::LinearRegex::Span> groups;
+    EXPECT_FALSE( regex->Search( text, 0, groups ) );
+    text.push_back( 'c' );
+    ASSERT_TRUE( regex->Search( text, 0, groups ) );
+    EXPECT_EQ( groups[0].begin, 0 );
+    EXPECT_EQ( groups[0].end, text.size() );
+
+    // 超长输入上的 ExtractAll 不会栈溢出
+    auto words = utils::CompiledRegex::Compile( R"((?:\w|\s)+)", nullptr, utils::RegexEngine::kLinear );
+    ASSERT_TRUE( words.Valid() );
+    const std::string long_text( 1 << 18, 'x' );
+    auto              result = utils::StringUtil::ExtractAll( long_text, words );
+    ASSERT_EQ( result.size(), 1 );
+    EXPECT_EQ( result[0].size(), long_text.size() );
+}
+
+TEST( LinearRegexTest, IterationWorstCase ) {
+    // 高优先级分支 \w+@ 一直存活到文本末尾：单次查找仍是线性的，但要扫描到末尾才能确定只匹配一个字符
+    auto regex = utils::LinearRegex::Compile( R"(\w+@|\w)" );
+    ASSERT_NE( regex, nullptr );
+    const std::string                     long_text( 1 << 16, 'a' );
+    std::vector<utils::LinearRegex::Span> groups;
+    ASSERT_TRUE( regex->Search( long_text, 0, groups ) );
+    EXPECT_EQ( groups[0].begin, 0 );
+    EXPECT_EQ( groups[0].end, 1 );
+
+    // 遍历所有匹配时每次查找都重新扫描到末尾，最坏为 O(n²)；这里只校验结果，规模保持较小
+    auto compiled = utils::CompiledRegex::Compile( R"(\w+@|\w)", nullptr, utils::RegexEngine::kLinear );
+    ASSERT_TRUE( compiled.Valid() );
+    const std::string text( 500, 'a' );
+    const auto        result = utils::StringUtil::ExtractAll( text, compiled );
+    ASSERT_EQ( result.size(), text.size() );
+    EXPECT_EQ( result.front(), "a" );
+    EXPECT_EQ( result.back(), "a" );
+}
+
+TEST( LinearRegexTest, EmptyIterationDiffersFromEcmaScript ) {
+    // 可匹配空串的分组被重复时接受空迭代，不像 ECMAScript 那样回溯寻找非空迭代，第0组范围也随之不同
+    struct Case {
+        const char *pattern;
+        std::string text;
+        size_t      begin;
+        size_t      end;
+    };
+    const std::vector<Case> cases = {
+        { R"(\d+?(?:b*?)?)", "c1bc", 1, 2 },   // ECMAScript: [1, 3)
+        { R"((.*?){1,2})", "__bc", 0, 0 },     // ECMAScript: [0, 1)
+        { R"((\s?[^a]*?)+)", "b\n _", 0, 3 },  // ECMAScript: [0, 4)
+    };
+    for ( const auto &c : cases ) {
+        auto regex = utils::LinearRegex::Compile( c.pattern );
+        ASSERT_NE( regex, nullptr ) << c.pattern;
+        std::vector<utils::LinearRegex::Span> groups;
+        ASSERT_TRUE( regex->Search( c.text, 0, groups ) ) << c.pattern;
+        EXPECT_EQ( groups[0].begin, c.begin ) << c.pattern;
+        EXPECT_EQ( groups[0].end, c.end ) << c.pattern;
+    }
+}
+
+TEST( LinearRegexTest, ExtractEngine ) {
+    std::string error_msg;
+    auto        date =
+        utils::CompiledRegex::Compile( R"((\d{4})-(\d{2})-(\d{2}))", &error_msg, utils::RegexEngine::kLinear );
+    ASSERT_TRUE( date.Valid() );
+    EXPECT_EQ( date.Engine(), utils::RegexEngine::kLinear );
+    EXPECT_EQ( utils::StringUtil::ExtractFirst( "Version 2024-01-02", date ), "2024-01-02" );
+    EXPECT_EQ( utils::StringUtil::ExtractGroup( "Version 2024-01-02", date, 2 ), "01" );
+    EXPECT_FALSE( utils::StringUtil::ExtractGroup( "Version 2024-01-02", date, 4, &error_msg ).has_value() );
+    EXPECT_FALSE( error_msg.empty() );
+    EXPECT_EQ( utils::StringUtil::ExtractAllGroups( "2023-12-25, 2024-01-01", date, 3 ),
+               ( std::vector<std::string>{ "25", "01" } ) );
+
+    // 不支持的语法编译失败
+    auto backref = utils::CompiledRegex::Compile( R"((a)\1)", &error_msg, utils::RegexEngine::kLinear );
+    EXPECT_FALSE( backref.Valid() );
+    EXPECT_FALSE( error_msg.empty() );
+
+    // 全局开关作用于字符串形式的 Extract*，两种引擎的缓存互不干扰
+    EXPECT_EQ( utils::StringUtil::GetRegexEngine(), utils::RegexEngine::kStd );
+    EXPECT_EQ( utils::StringUtil::ExtractFirst( "abab", R"((ab)\1)" ), "abab" );
+    utils::StringUtil::SetRegexEngine( utils::RegexEngine::kLinear );
+    EXPECT_EQ( utils::StringUtil::ExtractAll( "abc123def456", R"(\d+)" ),
+               ( std::vector<std::string>{ "123", "456" } ) );
+    EXPECT_EQ( utils::StringUtil::ExtractAll( "the quick brown fox jumps over the lazy dog", R"(\b\w{4}\b)" ),
+               ( std::vector<std::string>{ "over", "lazy" } ) );
+    EXPECT_FALSE( utils::StringUtil::ExtractFirst( "abab", R"((ab)\1)", &error_msg ).has_value() );
+    EXPECT_FALSE( error_msg.empty() );
+    utils::StringUtil::SetRegexEngine( utils::RegexEngine::kStd );
+    EXPECT_EQ( utils::StringUtil::ExtractFirst( "abab", R"((ab)\1)" ), "abab" );
+}
+
+TEST( LinearRegexTest, ConcurrentSearch ) {
+    auto regex = utils::CompiledRegex::Compile( R"((\w+)@(\w+)\.com)", nullptr, utils::RegexEngine::kLinear );
+    ASSERT_TRUE( regex.Valid() );
+
+    std::string text;
+    for ( int i = 0; i < 200; ++i ) {
+        text += "user" + std::to_string( i ) + "@host.com; ";
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<size_t>      counts( 4, 0 );
+    for ( size_t t = 0; t < counts.size(); ++t ) {
+        threads.emplace_back( [&, t]() {
+            for ( int round = 0; round < 20; ++round ) {
+                counts[t] += utils::StringUtil::ExtractAllGroups( text, regex, 2 ).size();
+            }
+        } );
+    }
+    for ( auto &thread : threads ) {
+        thread.join();
+    }
+    for ( const size_t count : counts ) {
+        EXPECT_EQ( count, 200 * 20 );
+    }
+}
@@ -0,0 +1,168 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "RegexStream.h"
+#include "StringUtil.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Found {
+    std::string text;
+    uint64_t    offset;
+};
+
+std::vector<std::string> FeedInChunks( const utils::CompiledRegex &regex, std::string_view input, size_t chunk_size,
+                                       size_t group_index = 0 ) {
+    std::vector<std::string>    result;
+    utils::RegexStreamExtractor extractor(
+        regex,
+        [&]( std::string_view match, uint64_t offset ) {
+            // 偏移必须指向原始输入中相同的内容
+            EXPECT_EQ( input.substr( offset, match.size() ), match );
+            result.emplace_back( match );
+            return true;
+        },
+        group_index );
+    EXPECT_TRUE( extractor.Valid() );
+    for ( size_t pos = 0; pos < input.size(); pos += chunk_size ) {
+        // 每块使用独立的临时缓冲，确保提取器不会引用已失效的数据
+        std::string chunk( input.substr( pos, chunk_size ) );
+        EXPECT_TRUE( extractor.Feed( chunk ) );
+    }
+    EXPECT_TRUE( extractor.Finish() );
+    EXPECT_EQ( extractor.Consumed(), input.size() );
+    return result;
+}
+
+}  // namespace
+
+TEST( RegexStreamTest, MatchesExtractAll ) {
+    const std::vector<std::pair<std::string, size_t>> patterns = {
+        { R"(\d+)", 0 },
+        { R"(\b\w{4}\b)", 0 },
+        { R"((\w+)@(\w+)\.com)", 2 },
+        { R"(^\w+)", 0 },
+        { R"(\w+$)", 0 },
+        { R"(x*)", 0 },
+        { R"(a|ab|abc)", 0 },
+        { R"(ERROR: ([^\n]*))", 1 },
+        { R"(\Bo\B)", 0 },
+        { R"(a*|b)", 0 },
+    };
+    const std::string input = "start 123 the quick brown fox jumps over the lazy dog\n"
+                              "ERROR: disk full\nuser1@host.com, bob@mail.com 4567 abcabab\n"
+                              "ERROR: timeout 89 over end";
+    for ( const auto &[pattern, group] : patterns ) {
+        auto regex = utils::CompiledRegex::Compile( pattern, nullptr, utils::RegexEngine::kLinear );
+        ASSERT_TRUE( regex.Valid() );
+        const auto expected = utils::StringUtil::ExtractAllGroups( input, regex, group );
+        for ( size_t chunk_size : { 1, 2, 3, 7, 16, 1000 } ) {
+            SCOPED_TRACE( pattern + " / chunk " + std::to_string( chunk_size ) );
+            EXPECT_EQ( FeedInChunks( regex, input, chunk_size, group ), expected );
+        }
+    }
+}
+
+TEST( RegexStreamTest, ZeroCopyAndCarry ) {
+    auto               regex = utils::CompiledRegex::Compile( R"(\d+)" );  // std 引擎会自动转为线性引擎
+    std::vector<Found> found;
+    std::vector<bool>  in_chunk;
+    std::string        chunk;
+
+    utils::RegexStreamExtractor extractor( regex, [&]( std::string_view match, uint64_t offset ) {
+        found.push_back( { std::string( match ), offset } );
+        in_chunk.push_back( match.data() >= chunk.data() && match.data() < chunk.data() + chunk.size() );
+        return true;
+    } );
+    ASSERT_TRUE( extractor.Valid() );
+
+    chunk = "a12 b34";
+    extractor.Feed( chunk );
+    chunk = "56 c7";
+    extractor.Feed( chunk );
+    extractor.Finish();
+
+    ASSERT_EQ( found.size(), 3 );
+    EXPECT_EQ( found[0].text, "12" );
+    EXPECT_EQ( found[0].offset, 1 );
+    EXPECT_EQ( found[1].text, "3456" );  // 跨块匹配
+    EXPECT_EQ( found[1].offset, 5 );
+    EXPECT_EQ( found[2].text, "7" );
+    EXPECT_EQ( found[2].offset, 11 );
+    // 块内匹配直接引用调用方数据，跨块匹配来自进位缓冲区
+    EXPECT_TRUE( in_chunk[0] );
+    EXPECT_FALSE( in_chunk[1] );
+}
+
+TEST( RegexStreamTest, StopAndInvalid ) {
+    auto                        regex = utils::CompiledRegex::Compile( R"(\d)" );
+    int                         count = 0;
+    utils::RegexStreamExtractor extractor( regex, [&]( std::string_view, uint64_t ) { return ++count < 2; } );
+    EXPECT_FALSE( extractor.Feed( "1 2 3 4" ) );
+    EXPECT_TRUE( extractor.Stopped() );
+    EXPECT_FALSE( extractor.Feed( "5" ) );
+    EXPECT_EQ( count, 2 );
+
+    auto noop = []( std::string_view, uint64_t ) { return true; };
+    // 线性引擎不支持反向引用
+    EXPECT_FALSE( utils::RegexStreamExtractor( utils::CompiledRegex::Compile( R"((a)\1)" ), noop ).Valid() );
+    EXPECT_FALSE( utils::RegexStreamExtractor( utils::CompiledRegex{}, noop ).Valid() );
+    // 捕获组越界
+    EXPECT_FALSE( utils::RegexStreamExtractor( regex, noop, 1 ).Valid() );
+}
+
+TEST( RegexStreamTest, MaxCarry ) {
+    auto regex = utils::CompiledRegex::Compile( R"([a-z]+|\d+)", nullptr, utils::RegexEngine::kLinear );
+
+    std::vector<std::string>    found;
+    utils::RegexStreamExtractor extractor(
+        regex,
+        [&]( std::string_view match, uint64_t ) {
+            found.emplace_back( match );
+            return true;
+        },
+        0, 8 );
+    // 超过上限的跨块候选被丢弃，之后的匹配不受影响
+    for ( int i = 0; i < 4; ++i ) {
+        extractor.Feed( "abcdef" );
+    }
+    extractor.Feed( " 12" );
+    extractor.Finish( "3 x" );
+    EXPECT_EQ( found, ( std::vector<std::string>{ "123", "x" } ) );
+}
+
+TEST( RegexStreamTest, ExtractFromFdAndFile ) {
+    char path[] = "/tmp/regex_stream_XXXXXX";
+    int  fd     = mkstemp( path );
+    ASSERT_GE( fd, 0 );
+
+    std::string content;
+    for ( int i = 0; i < 5000; ++i ) {
+        content += "line " + std::to_string( i ) + " id=" + std::to_string( i * 7 ) + "\n";
+    }
+    ASSERT_EQ( write( fd, content.data(), content.size() ), static_cast<ssize_t>( content.size() ) );
+    ASSERT_EQ( lseek( fd, 0, SEEK_SET ), 0 );
+
+    auto regex    = utils::CompiledRegex::Compile( R"(id=(\d+))", nullptr, utils::RegexEngine::kLinear );
+    auto expected = utils::StringUtil::ExtractAllGroups( content, regex, 1 );
+    ASSERT_EQ( expected.size(), 5000 );
+
+    std::vector<std::string> found;
+    auto                     collect = [&]( std::string_view match, uint64_t ) {
+        found.emplace_back( match );
+        return true;
+    };
+    EXPECT_TRUE( utils::RegexStreamExtractor::ExtractFromFd( fd, regex, collect, 1, 4096 ) );
+    EXPECT_EQ( found, expected );
+    close( fd );
+
+    found.clear();
+    EXPECT_TRUE( utils::RegexStreamExtractor::ExtractFromFile( path, regex, collect, 1 ) );
+    EXPECT_EQ( found, expected );
+
+    unlink( path );
+    EXPECT_FALSE( utils::RegexStreamExtractor::ExtractFromFile( path, regex, collect, 1 ) );
+}
@@ -0,0 +1,80 @@
+#include <string>
+#include "StringBuilder.h"
+#include "gtest/gtest.h"
+
+using utils::StringBuilder;
+
+TEST( StringBuilderTest, InlineAndHeap ) {
+    StringBuilder builder;
+    EXPECT_TRUE( builder.Empty() );
+    EXPECT_EQ( builder.Capacity(), StringBuilder::kInlineCapacity );
+
+    builder.Append( "hello" ).Append( ' ' ).Append( std::string( "world" ) );
+    EXPECT_EQ( builder.View(), "hello world" );
+    EXPECT_EQ( builder.Capacity(), StringBuilder::kInlineCapacity );
+
+    // 超过内联容量后转存到堆上，已有内容保持不变
+    std::string expected = "hello world";
+    for ( int i = 0; i < 100; ++i ) {
+        builder.Append( "0123456789" );
+        expected += "0123456789";
+    }
+    EXPECT_GT( builder.Capacity(), StringBuilder::kInlineCapacity );
+    EXPECT_EQ( builder.View(), expected );
+    EXPECT_EQ( builder.ToString(), expected );
+
+    const char *data   = builder.Data();
+    std::string result = std::move( builder ).ToString();
+    EXPECT_EQ( result, expected );
+    EXPECT_EQ( result.data(), data );  // 堆上的内容直接移出
+
+    StringBuilder small;
+    small.Append( "abc" );
+    EXPECT_EQ( std::move( small ).ToString(), "abc" );
+}
+
+TEST( StringBuilderTest, ReserveResizeClear ) {
+    StringBuilder builder;
+    builder.Reserve( 10 );
+    EXPECT_EQ( builder.Capacity(), StringBuilder::kInlineCapacity );
+    builder.Reserve( 1000 );
+    EXPECT_GE( builder.Capacity(), 1000 );
+    const char *data = builder.Data();
+    for ( int i = 0; i < 100; ++i ) {
+        builder.Append( "0123456789" );
+    }
+    EXPECT_EQ( builder.Data(), data );
+    EXPECT_EQ( builder.Size(), 1000 );
+
+    builder.Resize( 3 );
+    EXPECT_EQ( builder.View(), "012" );
+    builder.Clear();
+    EXPECT_TRUE( builder.Empty() );
+    EXPECT_GE( builder.Capacity(), 1000 );
+
+    StringBuilder inline_builder;
+    inline_builder.Resize( 4 );
+    std::char_traits<char>::copy( inline_builder.Data(), "abcd", 4 );
+    inline_builder.Resize( 300 );
+    EXPECT_EQ( inline_builder.Size(), 300 );
+    EXPECT_EQ( inline_builder.View().substr( 0, 4 ), "abcd" );
+}
+
+TEST( StringBuilderTest, AppendRepeated ) {
+    for ( size_t size : { 1, 2, 3, 7 } ) {
+        const std::string unit = std::string( "abcdefg" ).substr( 0, size );
+        for ( size_t times : { 0, 1, 2, 3, 5, 8, 100, 1000 } ) {
+            std::string expected = "<";
+            for ( size_t i = 0; i < times; ++i ) {
+                expected += unit;
+            }
+            StringBuilder builder;
+            builder.Append( '<' ).AppendRepeated( unit, times );
+            EXPECT_EQ( builder.View(), expected );
+        }
+    }
+    StringBuilder builder;
+    builder.AppendRepeated( "", 100 );
+    EXPECT_TRUE( builder.Empty() );
+    EXPECT_THROW( builder.AppendRepeated( "ab", static_cast<size_t>( -1 ) ), std::length_error );
+}
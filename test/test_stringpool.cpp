@@ -0,0 +1,84 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include "StringPool.h"
+#include "gtest/gtest.h"
+
+TEST( StringPoolTest, InternAndLookup ) {
+    utils::StringPool pool( 64 );
+    EXPECT_TRUE( pool.Empty() );
+
+    std::string host = "host-01";
+    auto        a    = pool.Intern( host );
+    auto        b    = pool.Intern( "INFO" );
+    auto        c    = pool.Intern( std::string_view( "host-01" ) );
+    EXPECT_EQ( a.view, "host-01" );
+    EXPECT_NE( a.view.data(), host.data() );  // 内容保存在池内
+    EXPECT_EQ( a.id, c.id );
+    EXPECT_EQ( a.view.data(), c.view.data() );
+    EXPECT_NE( a.id, b.id );
+    EXPECT_EQ( pool.Size(), 2 );
+
+    host = "changed";
+    EXPECT_EQ( a.view, "host-01" );
+    EXPECT_EQ( pool.Get( a.id ), "host-01" );
+    EXPECT_EQ( pool.Get( b.id ), "INFO" );
+    EXPECT_EQ( pool.Find( "INFO" ), b.id );
+    EXPECT_FALSE( pool.Find( "WARN" ).has_value() );
+
+    auto empty = pool.Intern( "" );
+    EXPECT_TRUE( empty.view.empty() );
+    EXPECT_EQ( pool.Intern( "" ).id, empty.id );
+
+    // 超过块大小一半的字符串单独分配，之前的视图保持有效
+    const std::string large( 1000, 'x' );
+    auto              big = pool.Intern( large );
+    EXPECT_EQ( big.view, large );
+    EXPECT_EQ( pool.Get( a.id ), "host-01" );
+    EXPECT_GE( pool.BytesAllocated(), large.size() );
+}
+
+TEST( StringPoolTest, ManyStringsHaveDenseIds ) {
+    utils::StringPool     pool;
+    std::vector<uint32_t> ids;
+    for ( int i = 0; i < 5000; ++i ) {
+        ids.push_back( pool.Intern( "value-" + std::to_string( i ) ).id );
+    }
+    ASSERT_EQ( pool.Size(), 5000 );
+    for ( int i = 0; i < 5000; ++i ) {
+        EXPECT_LT( ids[i], 5000 );
+        EXPECT_EQ( pool.Get( ids[i] ), "value-" + std::to_string( i ) );
+        EXPECT_EQ( pool.Intern( "value-" + std::to_string( i ) ).id, ids[i] );
+    }
+}
+
+TEST( StringPoolTest, ConcurrentIntern ) {
+    utils::StringPool pool( 256 );
+    const int         kThreads = 8;
+    const int         kWords   = 2000;
+
+    std::vector<std::vector<utils::StringPool::Interned>> results( kThreads );
+    std::vector<std::thread>                              threads;
+    for ( int t = 0; t < kThreads; ++t ) {
+        threads.emplace_back( [&, t] {
+            // 各线程以不同顺序驻留同一批字符串
+            for ( int i = 0; i < kWords; ++i ) {
+                const int word = ( i * ( 2 * t + 1 ) ) % kWords;
+                auto      item = pool.Intern( "word" + std::to_string( word ) );
+                EXPECT_EQ( pool.Get( item.id ), item.view );
+                results[t].push_back( item );
+            }
+        } );
+    }
+    for ( auto &thread : threads ) {
+        thread.join();
+    }
+
+    EXPECT_EQ( pool.Size(), kWords );
+    for ( int t = 0; t < kThreads; ++t ) {
+        for ( const auto &item : results[t] ) {
+            EXPECT_EQ( pool.Find( item.view ), item.id );
+            EXPECT_EQ( pool.Get( item.id ).data(), item.view.data() );
+        }
+    }
+}
@@ -1,5 +1,16 @@
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <list>
+#include <map>
+#include <optional>
+#include <set>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 #include "StringUtil.h"
 #include "gtest/gtest.h"
@@ -140,6 +151,141 @@ TEST( StringUtilTest, SplitCharMode ) {
     EXPECT_EQ( result_default_multi, expect_default_multi );
 }
 
+TEST( StringUtilTest, SplitSingleByte ) {
+    // 构造跨越多个16/32字节块的输入，分隔符分布在块边界两侧
+    std::string line;
+    for ( int i = 0; i < 50; ++i ) {
+        line += std::string( static_cast<size_t>( i % 7 ), 'a' + i % 26 );
+        line += ( i % 3 == 0 ) ? "||" : "|";
+    }
+    line += "tail";
+
+    // 与通用实现（多字节分隔符退化到单字节的逐字符模式）结果一致
+    auto fast      = utils::StringUtil::SplitRef( line, "|" );
+    auto char_mode = utils::StringUtil::SplitRef( line, "|", false, true );
+    EXPECT_EQ( fast, char_mode );
+    EXPECT_EQ( fast.back(), "tail" );
+
+    // 跳过空项时与SepStringView结果一致
+    auto fast_skip = utils::StringUtil::SplitRef( line, "|", true );
+    EXPECT_EQ( fast_skip, SepStringView( line, "|" ) );
+
+    // 子串引用指向原始缓冲区
+    std::string_view sv( line );
+    for ( const auto &part : fast ) {
+        EXPECT_TRUE( part.data() >= sv.data() && part.data() + part.size() <= sv.data() + sv.size() );
+    }
+
+    // 全部为分隔符
+    std::string all_sep( 40, '\t' );
+    EXPECT_EQ( utils::StringUtil::SplitRef( all_sep, "\t" ).size(), 41 );
+    EXPECT_TRUE( utils::StringUtil::SplitRef( all_sep, "\t", true ).empty() );
+
+    // 无分隔符
+    std::string no_sep( 100, 'x' );
+    std::vector<std::string_view> expect_no_sep{ no_sep };
+    EXPECT_EQ( utils::StringUtil::SplitRef( no_sep, "," ), expect_no_sep );
+
+    // 空输入
+    std::vector<std::string_view> expect_empty{ "" };
+    EXPECT_EQ( utils::StringUtil::SplitRef( "", "," ), expect_empty );
+    EXPECT_TRUE( utils::StringUtil::SplitRef( "", ",", true ).empty() );
+
+    // 不按输入长度预留结果（每字节16字节的 string_view），只随分段数量增长
+    std::string sparse( 1 << 20, 'x' );
+    for ( size_t i = 1000; i < sparse.size(); i += 1000 ) {
+        sparse[i] = ',';
+    }
+    auto sparse_parts = utils::StringUtil::SplitRef( sparse, "," );
+    EXPECT_EQ( sparse_parts.size(), sparse.size() / 1000 + 1 );
+    EXPECT_LT( sparse_parts.capacity(), sparse.size() / 100 );
+}
+
+TEST( StringUtilTest, SplitView ) {
+    auto collect = []( const utils::SplitRange &range ) {
+        return std::vector<std::string_view>( range.begin(), range.end() );
+    };
+
+    // 各种模式下与SplitRef结果一致
+    const std::vector<std::tuple<std::string_view, std::string_view, bool, bool>> cases{
+        { "a,b,c", ",", false, false },
+        { "a,,b,c,", ",", false, false },
+        { "a,,b,c,", ",", true, false },
+        { "abc", "", false, false },
+        { "abc", "", true, false },
+        { "a::b::::c", "::", false, false },
+        { "a::b::::c", "::", true, false },
+        { "2023-10-10 21:58:00.123", "- :.", false, true },
+        { "a,,b;;;c;", ",;", false, true },
+        { "a,,b;;;c;", ",;", true, true },
+        { "", ",", false, false },
+        { "", ",", true, false },
+        { "", "", false, false },
+    };
+    for ( const auto &[str, sep, skip, each] : cases ) {
+        EXPECT_EQ( collect( utils::StringUtil::SplitView( str, sep, skip, each ) ),
+                   utils::StringUtil::SplitRef( str, sep, skip, each ) )
+            << "str=" << str << " sep=" << sep << " skip=" << skip << " each=" << each;
+    }
+
+    // 只取前N个字段
+    auto range = utils::StringUtil::SplitView( "k1=v1;k2=v2;k3=v3", ";" );
+    auto iter  = range.begin();
+    EXPECT_EQ( *iter, "k1=v1" );
+    ++iter;
+    EXPECT_EQ( *iter, "k2=v2" );
+    EXPECT_EQ( iter->size(), 5 );
+
+    // 空范围
+    EXPECT_TRUE( utils::StringUtil::SplitView( ",,,", ",", true ).empty() );
+    EXPECT_FALSE( utils::StringUtil::SplitView( "", "," ).empty() );
+}
+
+TEST( StringUtilTest, CharSet ) {
+    utils::CharSet separators( ",;| \t" );
+    EXPECT_TRUE( separators.Contains( ',' ) );
+    EXPECT_TRUE( separators.Contains( '\t' ) );
+    EXPECT_FALSE( separators.Contains( 'a' ) );
+    EXPECT_FALSE( separators.Contains( '\0' ) );
+
+    // 与std::string_view::find_first_of/find_first_not_of结果一致，覆盖块内与块尾
+    std::string text;
+    for ( int i = 0; i < 100; ++i ) {
+        text += static_cast<char>( 'a' + i % 26 );
+    }
+    std::string_view sv( text );
+    for ( size_t pos : { size_t{ 0 }, size_t{ 5 }, size_t{ 31 }, size_t{ 64 }, size_t{ 99 } } ) {
+        std::string probe = text;
+        probe[pos]        = ';';
+        EXPECT_EQ( separators.FindFirst( probe ), pos );
+        EXPECT_EQ( separators.FindFirst( probe, pos + 1 ), std::string_view::npos );
+    }
+    EXPECT_EQ( separators.FindFirst( sv ), std::string_view::npos );
+    EXPECT_EQ( separators.FindFirst( "" ), std::string_view::npos );
+
+    const utils::CharSet lower = utils::CharSet::Range( 'a', 'z' );
+    EXPECT_TRUE( lower.AllOf( sv ) );
+    EXPECT_TRUE( lower.AllOf( "" ) );
+    EXPECT_EQ( lower.FindFirstNot( text + "A" ), text.size() );
+    EXPECT_EQ( lower.FindLastNot( "A" + text ), 0 );
+    EXPECT_EQ( lower.FindLastNot( sv ), std::string_view::npos );
+
+    // 高位字节与需要超过8个桶的集合（回退位图路径）
+    std::string high_bytes( 40, 'x' );
+    high_bytes += '\xFF';
+    EXPECT_EQ( utils::CharSet( "\xFF" ).FindFirst( high_bytes ), 40 );
+    EXPECT_EQ( lower.FindFirstNot( high_bytes ), 40 );
+    utils::CharSet scattered( "\x01\x12\x23\x34\x45\x56\x67\x78\x89\x9A" );
+    std::string    scattered_text( 50, 'z' );
+    scattered_text += '\x9A';
+    EXPECT_EQ( scattered.FindFirst( scattered_text ), 50 );
+
+    // 集合并
+    const utils::CharSet alnum = lower | utils::CharSet::Range( '0', '9' );
+    EXPECT_TRUE( alnum.AllOf( "abc123" ) );
+    EXPECT_FALSE( alnum.AllOf( "abc-123" ) );
+}
+
 TEST( StringUtilTest, ReplaceFirst ) {
     // 测试基本替换功能
     EXPECT_EQ( utils::StringUtil::ReplaceFirst( "hello world hello", "hello", "hi" ), "hi world hello" );
@@ -184,6 +330,86 @@ TEST( StringUtilTest, ReplaceAll ) {
     EXPECT_EQ( utils::StringUtil::ReplaceAll( "hello", "hello", "hello" ), "hello" );
 }
 
+TEST( StringUtilTest, ReplaceInPlace ) {
+    // ReplaceFirstInPlace
+    std::string first = "hello world hello";
+    EXPECT_TRUE( utils::StringUtil::ReplaceFirstInPlace( first, "hello", "hi" ) );
+    EXPECT_EQ( first, "hi world hello" );
+    EXPECT_FALSE( utils::StringUtil::ReplaceFirstInPlace( first, "xyz", "hi" ) );
+    EXPECT_FALSE( utils::StringUtil::ReplaceFirstInPlace( first, "", "hi" ) );
+    EXPECT_EQ( first, "hi world hello" );
+
+    // 替换为更短内容（原地压缩，不重新分配）
+    std::string shrink   = "a--b--c----d";
+    const char *data_ptr = shrink.data();
+    EXPECT_EQ( utils::StringUtil::ReplaceAllInPlace( shrink, "--", "-" ), 4 );
+    EXPECT_EQ( shrink, "a-b-c--d" );
+    EXPECT_EQ( shrink.data(), data_ptr );
+
+    // 等长与删除
+    std::string same = "abcabc";
+    EXPECT_EQ( utils::StringUtil::ReplaceAllInPlace( same, "b", "X" ), 2 );
+    EXPECT_EQ( same, "aXcaXc" );
+    std::string erase = "hello world hello";
+    EXPECT_EQ( utils::StringUtil::ReplaceAllInPlace( erase, "hello", "" ), 2 );
+    EXPECT_EQ( erase, " world " );
+
+    // 替换为更长内容
+    std::string grow = "abc abc abc";
+    EXPECT_EQ( utils::StringUtil::ReplaceAllInPlace( grow, "abc", "longer_string" ), 3 );
+    EXPECT_EQ( grow, "longer_string longer_string longer_string" );
+
+    // 自重叠模式与ReplaceAll语义一致
+    for ( const auto &to : { "", "b", "bbbb" } ) {
+        std::string overlap = "aaaaa";
+        utils::StringUtil::ReplaceAllInPlace( overlap, "aa", to );
+        EXPECT_EQ( overlap, utils::StringUtil::ReplaceAll( "aaaaa", "aa", to ) );
+    }
+
+    // 无匹配和空from
+    std::string none = "hello";
+    EXPECT_EQ( utils::StringUtil::ReplaceAllInPlace( none, "xyz", "" ), 0 );
+    EXPECT_EQ( utils::StringUtil::ReplaceAllInPlace( none, "", "x" ), 0 );
+    EXPECT_EQ( none, "hello" );
+
+    // from/to引用自身内容
+    std::string alias = "ab-ab-ab";
+    EXPECT_EQ( utils::StringUtil::ReplaceAllInPlace( alias, std::string_view( alias ).substr( 0, 2 ), "x" ), 3 );
+    EXPECT_EQ( alias, "x-x-x" );
+
+    // AppendReplaced追加到已有缓冲区
+    std::string out = "path=";
+    EXPECT_EQ( utils::StringUtil::AppendReplaced( out, "/a/b/c", "/", "::" ), 3 );
+    EXPECT_EQ( out, "path=::a::b::c" );
+    out.clear();
+    EXPECT_EQ( utils::StringUtil::AppendReplaced( out, "abc", "", "x" ), 0 );
+    EXPECT_EQ( out, "abc" );
+}
+
+TEST( StringUtilTest, ReplaceMany ) {
+    // 基本多模式替换
+    utils::ReplaceSet html{ { "&", "&amp;" }, { "<", "&lt;" }, { ">", "&gt;" } };
+    EXPECT_EQ( utils::StringUtil::ReplaceMany( "<a & b>", html ), "&lt;a &amp; b&gt;" );
+    EXPECT_EQ( utils::StringUtil::ReplaceMany( "plain text", html ), "plain text" );
+    EXPECT_EQ( utils::StringUtil::ReplaceMany( "", html ), "" );
+
+    // 替换结果不会被再次替换（与连续ReplaceAll不同）
+    utils::ReplaceSet swap{ { "a", "b" }, { "b", "a" } };
+    EXPECT_EQ( utils::StringUtil::ReplaceMany( "abba", swap ), "baab" );
+
+    // 同起点最长优先，最左优先
+    EXPECT_EQ( utils::StringUtil::ReplaceMany( "abcd", utils::ReplaceSet{ { "bc", "1" }, { "abc", "2" } } ), "2d" );
+    EXPECT_EQ( utils::StringUtil::ReplaceMany( "{{x}}", utils::ReplaceSet{ { "{x}", "1" }, { "{{x}}", "2" } } ), "2" );
+
+    // 模板占位符替换，删除与扩展
+    std::map<std::string, std::string> vars{ { "${user}", "alice" }, { "${host}", "example.com" }, { "#", "" } };
+    utils::ReplaceSet                  templates( vars );
+    EXPECT_EQ( utils::StringUtil::ReplaceMany( "#${user}@${host}#", templates ), "alice@example.com" );
+
+    // 空from被忽略
+    EXPECT_EQ( utils::StringUtil::ReplaceMany( "abc", utils::ReplaceSet{ { "", "x" }, { "b", "B" } } ), "aBc" );
+}
+
 TEST( StringUtilTest, EscapeC ) {
     // 测试基本转义字符
     EXPECT_EQ( utils::StringUtil::EscapeC( "Hello\nWorld" ), "Hello\\nWorld" );
@@ -235,6 +461,86 @@ TEST( StringUtilTest, UnescapeC ) {
     EXPECT_EQ( utils::StringUtil::UnescapeC( "" ), "" );
 }
 
+TEST( StringUtilTest, EscapeCAppend ) {
+    // 追加到已有内容之后
+    std::string out = "log: ";
+    utils::StringUtil::AppendEscapedC( out, "a\"b\n" );
+    EXPECT_EQ( out, "log: a\\\"b\\n" );
+    utils::StringUtil::AppendUnescapedC( out, "\\x41\\t" );
+    EXPECT_EQ( out, "log: a\\\"b\\nA\t" );
+
+    // 长串中转义点位于SIMD块边界附近及尾部
+    std::string all_bytes;
+    for ( int c = 0; c < 256; ++c ) {
+        all_bytes += std::string( c % 37, 'a' );
+        all_bytes += static_cast<char>( c );
+    }
+    const std::string escaped = utils::StringUtil::EscapeC( all_bytes );
+    for ( const char c : escaped ) {
+        EXPECT_TRUE( c >= 32 && c <= 126 );
+    }
+    EXPECT_EQ( utils::StringUtil::UnescapeC( escaped ), all_bytes );
+
+    // 不完整的转义序列在末尾原样保留
+    EXPECT_EQ( utils::StringUtil::UnescapeC( "abc\\" ), "abc\\" );
+    EXPECT_EQ( utils::StringUtil::UnescapeC( "abc\\x4" ), "abc\\x4" );
+    EXPECT_EQ( utils::StringUtil::UnescapeC( "\\xZ1tail" ), "\\xZ1tail" );
+}
+
+TEST( StringUtilTest, EscapeDialects ) {
+    using utils::EscapeDialect;
+    using utils::StringUtil;
+
+    // JSON
+    EXPECT_EQ( StringUtil::Escape( "say \"hi\"\n", EscapeDialect::kJson ), "say \\\"hi\\\"\\n" );
+    EXPECT_EQ( StringUtil::Escape( std::string( "\x01\b\f/\xE4\xB8\xAD", 7 ), EscapeDialect::kJson ),
+               "\\u0001\\b\\f/\xE4\xB8\xAD" );
+    EXPECT_EQ( StringUtil::Unescape( "\\u00e4\\u4E2D\\ud83d\\ude00\\/", EscapeDialect::kJson ),
+               "\xC3\xA4\xE4\xB8\xAD\xF0\x9F\x98\x80/" );
+    for ( const char *bad : { "\\", "\\x41", "\\u12", "\\u12G4", "\\ud83d", "\\ud83dx", "\\ude00" } ) {
+        EXPECT_FALSE( StringUtil::Unescape( bad, EscapeDialect::kJson ).has_value() ) << bad;
+    }
+
+    // URL
+    EXPECT_EQ( StringUtil::Escape( "a b&c", EscapeDialect::kUrl ), "a%20b%26c" );
+    EXPECT_EQ( StringUtil::Escape( "AZaz09-_.~/\xFF", EscapeDialect::kUrl ), "AZaz09-_.~%2F%FF" );
+    EXPECT_EQ( StringUtil::Unescape( "a%20b%2fc+d", EscapeDialect::kUrl ), "a b/c+d" );
+    for ( const char *bad : { "%", "%2", "a%G0", "%%" } ) {
+        EXPECT_FALSE( StringUtil::Unescape( bad, EscapeDialect::kUrl ).has_value() ) << bad;
+    }
+
+    // shell
+    EXPECT_EQ( StringUtil::Escape( "it's", EscapeDialect::kShell ), "'it'\\''s'" );
+    EXPECT_EQ( StringUtil::Escape( "/usr/bin/a-b_c.txt", EscapeDialect::kShell ), "/usr/bin/a-b_c.txt" );
+    EXPECT_EQ( StringUtil::Escape( "", EscapeDialect::kShell ), "''" );
+    EXPECT_EQ( StringUtil::Escape( "a b", EscapeDialect::kShell ), "'a b'" );
+    EXPECT_EQ( StringUtil::Unescape( R"(a\ b"c\"d$"'e"f')", EscapeDialect::kShell ), "a bc\"d$e\"f" );
+    for ( const char *bad : { "'abc", "\"abc", "abc\\" } ) {
+        EXPECT_FALSE( StringUtil::Unescape( bad, EscapeDialect::kShell ).has_value() ) << bad;
+    }
+
+    // C 方言与 EscapeC/UnescapeC 一致
+    EXPECT_EQ( StringUtil::Escape( "a\"b\n\x01", EscapeDialect::kC ), StringUtil::EscapeC( "a\"b\n\x01" ) );
+    EXPECT_EQ( StringUtil::Unescape( "\\x41\\q", EscapeDialect::kC ), "A\\q" );
+
+    // 所有字节的往返，转义点分布在SIMD块边界附近
+    std::string all_bytes;
+    for ( int c = 0; c < 256; ++c ) {
+        all_bytes += std::string( c % 37, 'a' );
+        all_bytes += static_cast<char>( c );
+    }
+    for ( auto dialect : { EscapeDialect::kC, EscapeDialect::kJson, EscapeDialect::kUrl, EscapeDialect::kShell } ) {
+        EXPECT_EQ( StringUtil::Unescape( StringUtil::Escape( all_bytes, dialect ), dialect ), all_bytes );
+    }
+
+    // 追加版本在失败时不改变已有内容
+    std::string out = "prefix:";
+    StringUtil::AppendEscaped( out, "a b", EscapeDialect::kUrl );
+    EXPECT_EQ( out, "prefix:a%20b" );
+    EXPECT_FALSE( StringUtil::AppendUnescaped( out, "ok%zz", EscapeDialect::kUrl ) );
+    EXPECT_EQ( out, "prefix:a%20b" );
+}
+
 TEST( StringUtilTest, WildcardMatch ) {
     // 测试基本通配符匹配
     EXPECT_TRUE( utils::StringUtil::WildcardMatch( "config.ini", "*.ini" ) );
@@ -266,6 +572,65 @@ TEST( StringUtilTest, WildcardMatch ) {
     EXPECT_FALSE( utils::StringUtil::WildcardMatch( "hello", "????" ) );
 }
 
+TEST( StringUtilTest, WildcardPattern ) {
+    // 各种快速路径
+    EXPECT_TRUE( utils::WildcardPattern( "config.ini" ).Match( "config.ini" ) );
+    EXPECT_FALSE( utils::WildcardPattern( "config.ini" ).Match( "config.ini2" ) );
+    EXPECT_TRUE( utils::WildcardPattern( "data?.dat" ).Match( "data1.dat" ) );
+    EXPECT_FALSE( utils::WildcardPattern( "data?.dat" ).Match( "data.dat" ) );
+    EXPECT_TRUE( utils::WildcardPattern( "log_*" ).Match( "log_2024" ) );
+    EXPECT_FALSE( utils::WildcardPattern( "log_*" ).Match( "lo" ) );
+    EXPECT_TRUE( utils::WildcardPattern( "*.ini" ).Match( "config.ini" ) );
+    EXPECT_FALSE( utils::WildcardPattern( "*.ini" ).Match( "config.txt" ) );
+    EXPECT_TRUE( utils::WildcardPattern( "**" ).Match( "" ) );
+    EXPECT_TRUE( utils::WildcardPattern( "" ).Match( "" ) );
+    EXPECT_FALSE( utils::WildcardPattern( "" ).Match( "a" ) );
+    EXPECT_TRUE( utils::WildcardPattern( "a*b?c*d" ).Match( "a__bxc__d" ) );
+    EXPECT_FALSE( utils::WildcardPattern( "a*b?c*d" ).Match( "a__bc__d" ) );
+    EXPECT_TRUE( utils::WildcardPattern( "*needle*" ).Match( "haystack with needle inside" ) );
+
+    // 与WildcardMatch逐一比较：{a,b,*,?}上长度<=4的所有模式 × {a,b}上长度<=5的所有字符串
+    std::vector<std::string> patterns{ "" };
+    std::vector<std::string> strings{ "" };
+    for ( size_t len = 1, begin = 0; len <= 5; ++len ) {
+        const size_t end = strings.size();
+        for ( size_t i = begin; i < end; ++i ) {
+            strings.push_back( strings[i] + "a" );
+            strings.push_back( strings[i] + "b" );
+        }
+        begin = end;
+    }
+    for ( size_t len = 1, begin = 0; len <= 4; ++len ) {
+        const size_t end = patterns.size();
+        for ( size_t i = begin; i < end; ++i ) {
+            for ( const char c : { 'a', 'b', '*', '?' } ) {
+                patterns.push_back( patterns[i] + c );
+            }
+        }
+        begin = end;
+    }
+    for ( const auto &pattern : patterns ) {
+        utils::WildcardPattern compiled( pattern );
+        for ( const auto &str : strings ) {
+            ASSERT_EQ( compiled.Match( str ), utils::StringUtil::WildcardMatch( str, pattern ) )
+                << "str=" << str << " pattern=" << pattern;
+        }
+    }
+
+    // 批量匹配
+    utils::WildcardPattern        logs( "*.log" );
+    std::vector<std::string_view> keys{ "a.log", "b.txt", "c.log", "log" };
+    std::vector<size_t>           matched{ 99 };
+    logs.MatchBatch( keys, matched );
+    EXPECT_EQ( matched, ( std::vector<size_t>{ 0, 2 } ) );
+    EXPECT_EQ( logs.Pattern(), "*.log" );
+
+    // 复制后仍然有效
+    utils::WildcardPattern copy = utils::WildcardPattern( "x?z*" );
+    utils::WildcardPattern moved( std::move( copy ) );
+    EXPECT_TRUE( moved.Match( "xyz123" ) );
+}
+
 TEST( StringUtilTest, ConvertByteUnit ) {
     // 测试基本单位转换
     EXPECT_DOUBLE_EQ( utils::StringUtil::ConvertByteUnit( 1.0, "MB", "KB" ), 1024.0 );
@@ -377,6 +742,12 @@ TEST( StringUtilTest, Join ) {
     s_set.insert( "2" );
     result = utils::StringUtil::Join( s_set, "-" );
     EXPECT_EQ( result, "1-2" );
+
+    // 字符容器，每个元素按单个字符拼接
+    result = utils::StringUtil::Join( std::vector<char>{ 'a', 'b', 'c' }, "," );
+    EXPECT_EQ( result, "a,b,c" );
+    result = utils::StringUtil::Join( std::list<char>{ 'x', 'y' }, ", " );
+    EXPECT_EQ( result, "x, y" );
 }
 
 TEST( StringUtilTest, Trim ) {
@@ -407,6 +778,31 @@ TEST( StringUtilTest, Trim ) {
 
     // 测试只有尾随空格
     EXPECT_EQ( utils::StringUtil::Trim( "test  " ), "test" );
+
+    // 测试单个字符
+    EXPECT_EQ( utils::StringUtil::Trim( "a" ), "a" );
+    EXPECT_EQ( utils::StringUtil::Trim( " 7 " ), "7" );
+
+    // 测试超过一个SIMD块的空白
+    EXPECT_EQ( utils::StringUtil::Trim( std::string( 40, ' ' ) + "x y" + std::string( 40, '\t' ) ), "x y" );
+}
+
+TEST( StringUtilTest, TrimRef ) {
+    const std::string text = " \t hello world \r\n";
+    const auto        view = utils::StringUtil::TrimRef( text );
+    EXPECT_EQ( view, "hello world" );
+    // 结果引用原字符串
+    EXPECT_EQ( view.data(), text.data() + 3 );
+    EXPECT_EQ( utils::StringUtil::TrimLeftRef( text ), "hello world \r\n" );
+    EXPECT_EQ( utils::StringUtil::TrimRightRef( text ), " \t hello world" );
+
+    EXPECT_EQ( utils::StringUtil::TrimRef( "" ), "" );
+    EXPECT_EQ( utils::StringUtil::TrimRef( "abc" ), "abc" );
+    const std::string blank = " \t\v\f ";
+    EXPECT_TRUE( utils::StringUtil::TrimRef( blank ).empty() );
+    EXPECT_TRUE( utils::StringUtil::TrimLeftRef( blank ).empty() );
+    EXPECT_TRUE( utils::StringUtil::TrimRightRef( blank ).empty() );
+    EXPECT_EQ( utils::StringUtil::TrimRef( std::string( 40, ' ' ) + "x" + std::string( 40, ' ' ) ), "x" );
 }
 
 TEST( StringUtilTest, Repeat ) {
@@ -450,6 +846,174 @@ TEST( StringUtilTest, ConvertToHex ) {
     EXPECT_EQ( utils::StringUtil::ToUpper( utils::StringUtil::ConvertToHexStr( ".-/&#" ) ), "2E 2D 2F 26 23" );
 }
 
+TEST( StringUtilTest, IgnoreCaseKernels ) {
+    using utils::StringUtil;
+
+    // 覆盖所有字节，非ASCII字母保持不变
+    std::string all_bytes;
+    for ( int round = 0; round < 3; ++round ) {
+        for ( int c = 0; c < 256; ++c ) {
+            all_bytes += static_cast<char>( c );
+        }
+    }
+    std::string lower = all_bytes;
+    std::string upper = all_bytes;
+    StringUtil::ToLowerInPlace( lower );
+    StringUtil::ToUpperInPlace( upper );
+    for ( size_t i = 0; i < all_bytes.size(); ++i ) {
+        const char c = all_bytes[i];
+        EXPECT_EQ( lower[i], c >= 'A' && c <= 'Z' ? c + 32 : c );
+        EXPECT_EQ( upper[i], c >= 'a' && c <= 'z' ? c - 32 : c );
+    }
+    EXPECT_TRUE( StringUtil::EqualsIgnoreCase( lower, upper ) );
+    EXPECT_EQ( StringUtil::ToLower( "Content-Type\xC3\x84" ), "content-type\xC3\x84" );
+
+    // 不同位置的差异，包括SIMD块之后的尾部
+    const std::string base = StringUtil::Repeat( "Header-Name:", 10 );
+    for ( size_t pos : { 0, 5, 31, 32, 33, 64, 100, 119 } ) {
+        std::string other = StringUtil::ToUpper( base );
+        EXPECT_TRUE( StringUtil::EqualsIgnoreCase( base, other ) );
+        other[pos] = '#';
+        EXPECT_FALSE( StringUtil::EqualsIgnoreCase( base, other ) ) << pos;
+    }
+    // '@' 与 '`'、'[' 与 '{' 只差 0x20，不是字母
+    EXPECT_FALSE( StringUtil::EqualsIgnoreCase( "@[", "`{" ) );
+    EXPECT_FALSE( StringUtil::EqualsIgnoreCase( std::string( 40, '@' ), std::string( 40, '`' ) ) );
+
+    // 查找
+    const std::string text = StringUtil::Repeat( "x", 70 ) + "Content-TYPE: Text/HTML; charset=UTF-8";
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "content-type" ), 70 );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "UTF-8" ), text.size() - 5 );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "text/html", 80 ), 84 );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "text/html", 85 ), std::string_view::npos );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "xx", 68 ), 68 );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "" ), 0 );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "", text.size() ), text.size() );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "", text.size() + 1 ), std::string_view::npos );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( "abc", "abcd" ), std::string_view::npos );
+    EXPECT_EQ( StringUtil::FindIgnoreCase( text, "charset=utf-16" ), std::string_view::npos );
+    for ( size_t pos = 0; pos + 4 <= text.size(); pos += 7 ) {
+        const std::string token = StringUtil::ToUpper( text.substr( pos, 4 ) );
+        EXPECT_EQ( StringUtil::FindIgnoreCase( text, token ), StringUtil::ToUpper( text ).find( token ) );
+    }
+
+    EXPECT_TRUE( StringUtil::ContainsIgnoreCase( "Connection: Keep-Alive", "keep-alive" ) );
+    EXPECT_FALSE( StringUtil::ContainsIgnoreCase( "Connection: close", "keep-alive" ) );
+    EXPECT_TRUE( StringUtil::StartWithIgnoreCase( "Content-Length: 12", "content-length:" ) );
+    EXPECT_FALSE( StringUtil::StartWithIgnoreCase( "Content", "content-length" ) );
+    EXPECT_TRUE( StringUtil::EndWithIgnoreCase( "index.HTML", ".html" ) );
+    EXPECT_FALSE( StringUtil::EndWithIgnoreCase( "index.htm", ".html" ) );
+}
+
+TEST( StringUtilTest, HexEncodeDecode ) {
+    using utils::StringUtil;
+
+    EXPECT_EQ( StringUtil::HexEncode( "" ), "" );
+    EXPECT_EQ( StringUtil::HexEncode( "\x12\xAB" ), "12ab" );
+    EXPECT_EQ( StringUtil::HexEncode( "\x12\xAB", ":", true ), "12:AB" );
+    EXPECT_EQ( StringUtil::HexEncode( "abc", ", " ), "61, 62, 63" );
+    EXPECT_EQ( StringUtil::HexDecode( "12aB" ), "\x12\xAB" );
+    EXPECT_EQ( StringUtil::HexDecode( "61, 62, 63", ", " ), "abc" );
+    EXPECT_EQ( StringUtil::HexDecode( "" ), "" );
+    for ( const char *bad : { "1", "12a", "1g", "12 34", "12:34:" } ) {
+        EXPECT_FALSE( StringUtil::HexDecode( bad ).has_value() ) << bad;
+    }
+    EXPECT_FALSE( StringUtil::HexDecode( "12-34", ":" ).has_value() );
+
+    // 长数据覆盖SIMD块及尾部，非法字符出现在块内的不同位置
+    std::string data;
+    for ( int i = 0; i < 1000; ++i ) {
+        data += static_cast<char>( i * 7 );
+    }
+    for ( size_t size : { 15, 16, 17, 31, 32, 33, 100, 1000 } ) {
+        const std::string_view part( data.data(), size );
+        const std::string      lower = StringUtil::HexEncode( part );
+        const std::string      upper = StringUtil::HexEncode( part, {}, true );
+        EXPECT_EQ( StringUtil::ToUpper( lower ), upper );
+        EXPECT_EQ( StringUtil::HexDecode( lower ), part );
+        EXPECT_EQ( StringUtil::HexDecode( upper ), part );
+        EXPECT_EQ( StringUtil::HexDecode( StringUtil::HexEncode( part, "-" ), "-" ), part );
+        for ( size_t bad_pos : { size_t( 0 ), size * 2 / 3, size * 2 - 1 } ) {
+            std::string broken = lower;
+            broken[bad_pos]    = 'x';
+            EXPECT_FALSE( StringUtil::HexDecode( broken ).has_value() );
+        }
+    }
+
+    std::string out = "id=";
+    StringUtil::AppendHexEncoded( out, "\xFF" );
+    EXPECT_EQ( out, "id=ff" );
+    EXPECT_TRUE( StringUtil::AppendHexDecoded( out, "2a" ) );
+    EXPECT_EQ( out, "id=ff*" );
+    EXPECT_FALSE( StringUtil::AppendHexDecoded( out, "zz" ) );
+    EXPECT_EQ( out, "id=ff*" );
+}
+
+TEST( StringUtilTest, Base64 ) {
+    using utils::Base64Alphabet;
+    using utils::StringUtil;
+
+    // RFC 4648 测试向量
+    const std::pair<const char *, const char *> vectors[] = {
+        { "", "" },         { "f", "Zg==" },        { "fo", "Zm8=" },         { "foo", "Zm9v" },
+        { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+    };
+    for ( const auto &[plain, encoded] : vectors ) {
+        EXPECT_EQ( StringUtil::Base64Encode( plain ), encoded );
+        EXPECT_EQ( StringUtil::Base64Decode( encoded ), plain );
+    }
+    EXPECT_EQ( StringUtil::Base64Encode( "\xFB\xFF", Base64Alphabet::kUrlSafe, false ), "-_8" );
+    EXPECT_EQ( StringUtil::Base64Encode( "\xFB\xFF" ), "+/8=" );
+    EXPECT_EQ( StringUtil::Base64Decode( "-_8", Base64Alphabet::kUrlSafe ), "\xFB\xFF" );
+    EXPECT_EQ( StringUtil::Base64Decode( "Zm9vYg" ), "foob" );
+
+    // 严格模式
+    for ( const char *bad : { "Z", "Zm9vY", "Zg=", "Zg===", "Zm9v=", "Zh==", "Zm9=", "Zm 9v", "-_8=", "Zg==Zg==" } ) {
+        EXPECT_FALSE( StringUtil::Base64Decode( bad ).has_value() ) << bad;
+    }
+    // 宽松模式：空白、混用字母表、不完整填充、多余比特
+    EXPECT_EQ( StringUtil::Base64Decode( " Zm9v\r\nYmFy\n", Base64Alphabet::kStandard, false ), "foobar" );
+    EXPECT_EQ( StringUtil::Base64Decode( "-_8=", Base64Alphabet::kStandard, false ), "\xFB\xFF" );
+    EXPECT_EQ( StringUtil::Base64Decode( "Zg=", Base64Alphabet::kStandard, false ), "f" );
+    EXPECT_EQ( StringUtil::Base64Decode( "Zh", Base64Alphabet::kStandard, false ), "f" );
+    EXPECT_FALSE( StringUtil::Base64Decode( "Zm9v!", Base64Alphabet::kStandard, false ).has_value() );
+    EXPECT_FALSE( StringUtil::Base64Decode( "Zm9vY", Base64Alphabet::kStandard, false ).has_value() );
+
+    // 长数据覆盖SIMD块及尾部
+    std::string data;
+    for ( int i = 0; i < 2000; ++i ) {
+        data += static_cast<char>( i * 13 + i / 7 );
+    }
+    for ( size_t size : { 23, 24, 27, 28, 29, 47, 48, 100, 1000, 2000 } ) {
+        const std::string_view part( data.data(), size );
+        for ( auto alphabet : { Base64Alphabet::kStandard, Base64Alphabet::kUrlSafe } ) {
+            const std::string encoded = StringUtil::Base64Encode( part, alphabet );
+            EXPECT_EQ( StringUtil::Base64Decode( encoded, alphabet ), part );
+            EXPECT_EQ( StringUtil::Base64Decode( StringUtil::Base64Encode( part, alphabet, false ), alphabet ), part );
+
+            // 非法字符出现在不同位置
+            for ( size_t bad_pos : { size_t( 0 ), encoded.size() / 2, encoded.size() - 5 } ) {
+                std::string broken = encoded;
+                broken[bad_pos]    = '*';
+                EXPECT_FALSE( StringUtil::Base64Decode( broken, alphabet ).has_value() );
+            }
+
+            // 每76个字符换行
+            std::string wrapped;
+            for ( size_t pos = 0; pos < encoded.size(); pos += 76 ) {
+                wrapped += encoded.substr( pos, 76 ) + "\r\n";
+            }
+            EXPECT_EQ( StringUtil::Base64Decode( wrapped, alphabet, false ), part );
+        }
+    }
+
+    std::string out = "data:";
+    StringUtil::AppendBase64Encoded( out, "hi" );
+    EXPECT_EQ( out, "data:aGk=" );
+    EXPECT_FALSE( StringUtil::AppendBase64Decoded( out, "a$==" ) );
+    EXPECT_EQ( out, "data:aGk=" );
+}
+
 TEST( StringUtilTest, EqualsIgnoreCase ) {
     // 测试相等的字符串（大小写不同）
     EXPECT_TRUE( utils::StringUtil::EqualsIgnoreCase( "Hello", "hello" ) );
@@ -678,6 +1242,66 @@ TEST( StringUtilTest, RegexExtractAllGroups ) {
     EXPECT_FALSE( error_msg.empty() );
 }
 
+TEST( StringUtilTest, RegexCompiled ) {
+    std::string error_msg;
+
+    // 预编译正则
+    auto digits = utils::CompiledRegex::Compile( R"(\d+)", &error_msg );
+    ASSERT_TRUE( digits.Valid() );
+    EXPECT_TRUE( error_msg.empty() );
+    EXPECT_EQ( digits.Pattern(), R"(\d+)" );
+    EXPECT_EQ( utils::StringUtil::ExtractFirst( "abc123def456", digits ), "123" );
+    EXPECT_EQ( utils::StringUtil::ExtractAll( "abc123def456", digits ), ( std::vector<std::string>{ "123", "456" } ) );
+
+    auto date = utils::CompiledRegex::Compile( R"((\d{4})-(\d{2})-(\d{2}))" );
+    EXPECT_EQ( utils::StringUtil::ExtractGroup( "Version 2024-01-02", date, 2 ), "01" );
+    EXPECT_EQ( utils::StringUtil::ExtractAllGroups( "2023-12-25, 2024-01-01", date, 1 ),
+               ( std::vector<std::string>{ "2023", "2024" } ) );
+
+    // 编译失败
+    auto invalid = utils::CompiledRegex::Compile( R"([)", &error_msg );
+    EXPECT_FALSE( invalid.Valid() );
+    EXPECT_FALSE( error_msg.empty() );
+    EXPECT_TRUE( invalid.Pattern().empty() );
+    EXPECT_FALSE( utils::StringUtil::ExtractFirst( "test", invalid, &error_msg ).has_value() );
+    EXPECT_FALSE( error_msg.empty() );
+    EXPECT_TRUE( utils::StringUtil::ExtractAll( "test", utils::CompiledRegex{}, &error_msg ).empty() );
+    EXPECT_FALSE( error_msg.empty() );
+
+    // 复制共享同一编译结果
+    utils::CompiledRegex copy = digits;
+    EXPECT_EQ( utils::StringUtil::ExtractFirst( "x9", copy ), "9" );
+
+    // 缓存容量变化不影响结果
+    utils::StringUtil::SetRegexCacheCapacity( 1 );
+    for ( int i = 0; i < 3; ++i ) {
+        EXPECT_EQ( utils::StringUtil::ExtractFirst( "a1b", R"(\d)" ), "1" );
+        EXPECT_EQ( utils::StringUtil::ExtractFirst( "a1b", R"([a-z])" ), "a" );
+    }
+    utils::StringUtil::SetRegexCacheCapacity( 0 );
+    EXPECT_EQ( utils::StringUtil::ExtractFirst( "a1b", R"(\d)" ), "1" );
+    utils::StringUtil::ClearRegexCache();
+    utils::StringUtil::SetRegexCacheCapacity( 128 );
+
+    // 多线程使用缓存
+    std::vector<std::thread> threads;
+    std::atomic<int>         failures{ 0 };
+    for ( int t = 0; t < 4; ++t ) {
+        threads.emplace_back( [&failures, t] {
+            for ( int i = 0; i < 200; ++i ) {
+                const std::string pattern = "x" + std::to_string( ( i + t ) % 10 );
+                if ( utils::StringUtil::ExtractFirst( "ax" + std::to_string( ( i + t ) % 10 ), pattern ) != pattern ) {
+                    ++failures;
+                }
+            }
+        } );
+    }
+    for ( auto &thread : threads ) {
+        thread.join();
+    }
+    EXPECT_EQ( failures.load(), 0 );
+}
+
 TEST( StringUtilTest, ToNumber ) {
     // 测试整数转换
     EXPECT_EQ( utils::StringUtil::ToNumber<int>( "42" ).value_or( 0 ), 42 );
@@ -724,6 +1348,75 @@ TEST( StringUtilTest, ToNumber ) {
     EXPECT_TRUE( noexcept( utils::StringUtil::ToNumber<bool>( "1" ) ) );
 }
 
+TEST( StringUtilTest, ParseNumbers ) {
+    using utils::StringUtil;
+
+    std::vector<int> ints;
+    auto             result = StringUtil::ParseNumbers( " 1, -2 ,+3,\t4\r\n", ',', ints );
+    EXPECT_TRUE( result );
+    EXPECT_EQ( result.count, 4 );
+    EXPECT_EQ( ints, ( std::vector<int>{ 1, -2, 3, 4 } ) );
+
+    // 结尾的分隔符和空输入
+    EXPECT_TRUE( StringUtil::ParseNumbers( "1\n2\n", '\n', ints ) );
+    EXPECT_EQ( ints, ( std::vector<int>{ 1, 2 } ) );
+    EXPECT_TRUE( StringUtil::ParseNumbers( "", ',', ints ) );
+    EXPECT_TRUE( ints.empty() );
+
+    // 出错位置
+    result = StringUtil::ParseNumbers( "1,2x,3", ',', ints );
+    EXPECT_FALSE( result );
+    EXPECT_EQ( result.error, std::errc::invalid_argument );
+    EXPECT_EQ( result.error_pos, 3 );
+    EXPECT_EQ( ints, ( std::vector<int>{ 1 } ) );
+    result = StringUtil::ParseNumbers( "1,,3", ',', ints );
+    EXPECT_EQ( result.error_pos, 2 );
+    result = StringUtil::ParseNumbers( "1, 2147483648", ',', ints );
+    EXPECT_EQ( result.error, std::errc::result_out_of_range );
+    EXPECT_EQ( result.error_pos, 3 );
+    result = StringUtil::ParseNumbers( "1 2", ',', ints );
+    EXPECT_EQ( result.error_pos, 1 );
+    result = StringUtil::ParseNumbers( "-", ',', ints );
+    EXPECT_EQ( result.error, std::errc::invalid_argument );
+
+    // 整型边界与8位一组的快速路径
+    std::vector<int64_t> longs;
+    EXPECT_TRUE( StringUtil::ParseNumbers( "-9223372036854775808,9223372036854775807,00000000000000000012", ',',
+                                           longs ) );
+    EXPECT_EQ( longs, ( std::vector<int64_t>{ INT64_MIN, INT64_MAX, 12 } ) );
+    EXPECT_EQ( StringUtil::ParseNumbers( "9223372036854775808", ',', longs ).error, std::errc::result_out_of_range );
+    std::vector<uint64_t> ulongs;
+    EXPECT_TRUE( StringUtil::ParseNumbers( "18446744073709551615;12345678;123456789", ';', ulongs ) );
+    EXPECT_EQ( ulongs, ( std::vector<uint64_t>{ UINT64_MAX, 12345678, 123456789 } ) );
+    EXPECT_EQ( StringUtil::ParseNumbers( "18446744073709551616", ';', ulongs ).error,
+               std::errc::result_out_of_range );
+    EXPECT_EQ( StringUtil::ParseNumbers( "1;-1", ';', ulongs ).error_pos, 2 );
+    EXPECT_EQ( StringUtil::ParseNumbers( "123456789012a4", ';', ulongs ).error_pos, 12 );
+    std::vector<uint8_t> bytes;
+    EXPECT_EQ( StringUtil::ParseNumbers( "255,256", ',', bytes ).error, std::errc::result_out_of_range );
+
+    // 与逐个 ToNumber 的结果一致
+    std::string           csv;
+    std::vector<uint32_t> expected;
+    for ( uint32_t i = 0; i < 2000; ++i ) {
+        expected.push_back( i * 2654435761u );
+        csv += std::to_string( expected.back() ) + ",";
+    }
+    std::vector<uint32_t> parsed;
+    EXPECT_TRUE( StringUtil::ParseNumbers( csv, ',', parsed ) );
+    EXPECT_EQ( parsed, expected );
+
+    // 浮点
+    std::vector<double> doubles;
+    EXPECT_TRUE( StringUtil::ParseNumbers( "1.5 | -2e3 | +0.25 | 7", '|', doubles ) );
+    EXPECT_EQ( doubles, ( std::vector<double>{ 1.5, -2000, 0.25, 7 } ) );
+    result = StringUtil::ParseNumbers( "1.5|2.5.1", '|', doubles );
+    EXPECT_EQ( result.error_pos, 7 );
+    result = StringUtil::ParseNumbers( "1.5|+-2", '|', doubles );
+    EXPECT_EQ( result.error_pos, 4 );
+    EXPECT_EQ( StringUtil::ParseNumbers( "1e999", '|', doubles ).error, std::errc::result_out_of_range );
+}
+
 TEST( StringUtilTest, FromNumber ) {
     // 测试整型转换
     EXPECT_EQ( utils::StringUtil::FromNumber<int>( 42 ), "42" );
@@ -775,6 +1468,52 @@ TEST( StringUtilTest, FromNumber ) {
     EXPECT_TRUE( noexcept( utils::StringUtil::FromNumber<float>( 3.14f, 10, -1 ) ) );
 }
 
+TEST( StringUtilTest, FormatNumberTo ) {
+    using utils::StringUtil;
+
+    // 最短往返表示
+    EXPECT_EQ( StringUtil::FromNumber( 0.1 + 0.2 ), "0.30000000000000004" );
+    EXPECT_EQ( StringUtil::FromNumber( 1e21 ), "1e+21" );
+    EXPECT_EQ( StringUtil::FromNumber( 123456789.0 ), "123456789" );
+    EXPECT_EQ( StringUtil::FromNumber( 0.1f ), "0.1" );
+    EXPECT_EQ( StringUtil::FromNumber( -0.0 ), "-0" );
+    for ( double value : { 1.0 / 3, 2.0 / 3e100, 6.02214076e23, 5e-324, 1.7976931348623157e308 } ) {
+        EXPECT_EQ( StringUtil::ToNumber<double>( StringUtil::FromNumber( value ) ), value );
+    }
+
+    // 超出栈缓冲区的定点格式
+    const std::string big = StringUtil::FromNumber( 1e300, 10, 2 );
+    EXPECT_EQ( big.size(), 301 + 3 );
+    EXPECT_EQ( big.substr( 0, 2 ), "10" );
+    EXPECT_EQ( big.substr( big.size() - 3 ), ".00" );
+
+    char  buffer[8];
+    char *end = StringUtil::FormatNumberTo( buffer, buffer + sizeof( buffer ), 2.5 );
+    ASSERT_NE( end, nullptr );
+    EXPECT_EQ( std::string_view( buffer, end - buffer ), "2.5" );
+    end = StringUtil::FormatNumberTo( buffer, buffer + sizeof( buffer ), -255, 16 );
+    EXPECT_EQ( std::string_view( buffer, end - buffer ), "-ff" );
+    EXPECT_EQ( StringUtil::FormatNumberTo( buffer, buffer + sizeof( buffer ), 123456789 ), nullptr );
+    EXPECT_EQ( StringUtil::FormatNumberTo( buffer, buffer + sizeof( buffer ), 1, 2 ), nullptr );
+
+    std::string out = "v=";
+    EXPECT_TRUE( StringUtil::AppendNumber( out, 1.5 ) );
+    out += ',';
+    EXPECT_TRUE( StringUtil::AppendNumber( out, 1.0 / 3, 10, 3 ) );
+    EXPECT_FALSE( StringUtil::AppendNumber( out, 7, 3 ) );
+    EXPECT_EQ( out, "v=1.5,0.333" );
+
+    // StringFormatter 的浮点输出与流格式化一致
+    for ( double value : { 3.14159265, 1e-5, 123456789.0, -0.5, 1e100 } ) {
+        std::ostringstream oss;
+        oss << value;
+        EXPECT_EQ( utils::StringFormatter( "%1" ).Args( value ).ToString(), oss.str() );
+        oss.str( "" );
+        oss << std::fixed << std::setprecision( 3 ) << value;
+        EXPECT_EQ( utils::StringFormatter( "%1" ).ArgsF( 3, value ).ToString(), oss.str() );
+    }
+}
+
 TEST( StringUtilTest, StringFormat ) {
     // 测试基本字符串格式化功能
     utils::StringFormatter fmt1( "Hello %1, welcome to %2!" );
@@ -838,6 +1577,56 @@ TEST( StringUtilTest, StringFormat ) {
     EXPECT_EQ( result12, "a b a c b a 3.140 55" );
 }
 
+TEST( StringUtilTest, CompiledStringFormat ) {
+    const auto tpl = utils::StringFormatter::Compile( "%1 %2 -> %3 (%4 ms)" );
+    EXPECT_EQ( tpl.MaxArgIndex(), 4 );
+    EXPECT_EQ( tpl.Render( "GET", std::string( "/index.html" ), 200, 1.25 ), "GET /index.html -> 200 (1.25 ms)" );
+    // 同一模板可反复渲染
+    EXPECT_EQ( tpl.Render( "PUT", std::string_view( "/a" ), 404, 0.5 ), "PUT /a -> 404 (0.5 ms)" );
+
+    // 缺少的参数保留占位符，重复引用、乱序引用
+    EXPECT_EQ( tpl.Render( "GET" ), "GET %2 -> %3 (%4 ms)" );
+    EXPECT_EQ( utils::StringFormatter::Compile( "%2%1%2" ).Render( 'a', true ), "true97true" );
+    EXPECT_EQ( utils::StringFormatter::Compile( "%10|%1|%1x" ).Render( 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 ), "10|1|1x" );
+
+    // %0、以0开头的序号、单独的%均为普通文本
+    EXPECT_EQ( utils::StringFormatter::Compile( "100% %0 %01 %" ).Render( "x" ), "100% %0 %01 %" );
+    EXPECT_EQ( utils::StringFormatter::Compile( "" ).Render( 1 ), "" );
+    EXPECT_EQ( utils::StringFormatter::Compile( "plain" ).MaxArgIndex(), 0 );
+
+    // 参数内容中的占位符不会被再次替换
+    EXPECT_EQ( utils::StringFormatter::Compile( "%1-%2" ).Render( "%2", "b" ), "%2-b" );
+
+    // 与 Args 的结果一致
+    const char *formats[] = { "Hello %1, welcome to %2!", "%1%2%3", "x=%1 y=%2 z=%3 again %1", "%3 only" };
+    for ( const char *format : formats ) {
+        EXPECT_EQ( utils::StringFormatter::Compile( format ).Render( "ab", 3.14159, -7 ),
+                   utils::StringFormatter( format ).Args( "ab", 3.14159, -7 ).ToString() );
+    }
+
+    std::string out = "log: ";
+    utils::StringFormatter::Compile( "[%1]" ).RenderTo( out, 42 );
+    EXPECT_EQ( out, "log: [42]" );
+
+    // 多线程共享同一个模板
+    std::vector<std::thread> threads;
+    std::atomic<int>         mismatches{ 0 };
+    for ( int t = 0; t < 4; ++t ) {
+        threads.emplace_back( [&, t]() {
+            for ( int i = 0; i < 1000; ++i ) {
+                if ( tpl.Render( "T", t, i, 0.5 ) != "T " + std::to_string( t ) + " -> " + std::to_string( i ) +
+                                                         " (0.5 ms)" ) {
+                    ++mismatches;
+                }
+            }
+        } );
+    }
+    for ( auto &thread : threads ) {
+        thread.join();
+    }
+    EXPECT_EQ( mismatches, 0 );
+}
+
 TEST( StringUtilTest, Vasprintf ) {
     // 测试基本的格式化功能
     std::string result = utils::StringUtil::FormatCString( "Hello %s", "World" );
@@ -935,6 +1724,319 @@ TEST( StringUtilTest, RandomString ) {
     EXPECT_TRUE( zero_length.empty() );
 }
 
+TEST( StringUtilTest, RandomStringDistribution ) {
+    // 2的幂字符集（位掩码路径）、一般字符集（字节拒绝采样）和超过256个字符的字符集都应覆盖所有字符且大致均匀
+    std::string large_charset;
+    for ( int i = 0; i < 300; ++i ) {
+        large_charset += static_cast<char>( 'a' + i % 26 );
+    }
+    for ( std::string_view charset : { std::string_view( "01" ), std::string_view( "0123456789abcdef" ),
+                                       std::string_view( "0123456789" ), std::string_view( "x" ),
+                                       std::string_view( large_charset ) } ) {
+        const size_t length = 100000;
+        auto         str    = utils::StringUtil::RandomString( length, charset );
+        ASSERT_EQ( str.size(), length );
+        std::map<char, size_t> counts;
+        for ( char c : str ) {
+            ++counts[c];
+        }
+        std::map<char, size_t> weights;
+        for ( char c : charset ) {
+            ++weights[c];
+        }
+        ASSERT_EQ( counts.size(), weights.size() ) << charset;
+        for ( const auto &[c, count] : counts ) {
+            const double expected = static_cast<double>( length ) * weights[c] / charset.size();
+            EXPECT_NEAR( count, expected, expected * 0.1 + 50 ) << charset << " / " << c;
+        }
+    }
+
+    char buffer[7] = { 0 };
+    EXPECT_EQ( utils::StringUtil::RandomStringTo( buffer, buffer + 6, "AB" ), buffer + 6 );
+    EXPECT_EQ( std::string_view( buffer ).find_first_not_of( "AB" ), std::string_view::npos );
+    EXPECT_EQ( utils::StringUtil::RandomStringTo( buffer, buffer + 6, "" ), buffer );
+}
+
+TEST( StringUtilTest, Uuid ) {
+    auto check_format = []( const std::string &uuid, char version ) {
+        ASSERT_EQ( uuid.size(), utils::StringUtil::kUuidLength );
+        for ( size_t i = 0; i < uuid.size(); ++i ) {
+            if ( i == 8 || i == 13 || i == 18 || i == 23 ) {
+                EXPECT_EQ( uuid[i], '-' ) << uuid;
+            }
+            else {
+                EXPECT_TRUE( std::isxdigit( static_cast<unsigned char>( uuid[i] ) ) && !std::isupper( uuid[i] ) )
+                    << uuid;
+            }
+        }
+        EXPECT_EQ( uuid[14], version ) << uuid;
+        EXPECT_NE( std::string_view( "89ab" ).find( uuid[19] ), std::string_view::npos ) << uuid;
+    };
+
+    std::set<std::string> seen;
+    std::string           prev_v7;
+    for ( int i = 0; i < 10000; ++i ) {
+        auto v4 = utils::StringUtil::UuidV4();
+        check_format( v4, '4' );
+        EXPECT_TRUE( seen.insert( v4 ).second );
+
+        // 同一线程内版本7按字典序严格递增
+        auto v7 = utils::StringUtil::UuidV7();
+        check_format( v7, '7' );
+        EXPECT_GT( v7, prev_v7 );
+        prev_v7 = v7;
+    }
+
+    // 时间戳部分应接近当前时间
+    const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::system_clock::now().time_since_epoch() )
+                            .count();
+    const auto v7_ms  = std::stoll( prev_v7.substr( 0, 8 ) + prev_v7.substr( 9, 4 ), nullptr, 16 );
+    EXPECT_LE( std::llabs( now_ms - v7_ms ), 10000 );
+
+    char buffer[utils::StringUtil::kUuidLength];
+    EXPECT_EQ( utils::StringUtil::UuidV4To( buffer, buffer + sizeof( buffer ) ), buffer + sizeof( buffer ) );
+    EXPECT_EQ( utils::StringUtil::UuidV7To( buffer, buffer + sizeof( buffer ) ), buffer + sizeof( buffer ) );
+    EXPECT_EQ( utils::StringUtil::UuidV4To( buffer, buffer + sizeof( buffer ) - 1 ), nullptr );
+    EXPECT_EQ( utils::StringUtil::UuidV7To( buffer, buffer + sizeof( buffer ) - 1 ), nullptr );
+}
+
+TEST( StringUtilTest, Hash ) {
+    using utils::StringUtil;
+    std::string data;
+    for ( int i = 0; i < 300; ++i ) {
+        data += static_cast<char>( "AbCdEfGhIjKlMnOpQrStUvWxYz0123456789-_[]@`{}\x80\xff"[i % 58] );
+    }
+
+    // 各长度分支（0、1~3、4~16、17~47、>=48）结果稳定且与种子相关
+    std::set<uint64_t> hashes;
+    for ( size_t len = 0; len <= data.size(); ++len ) {
+        const std::string_view str( data.data(), len );
+        const uint64_t         h = StringUtil::Hash( str );
+        EXPECT_EQ( h, StringUtil::Hash( std::string( str ) ) );
+        EXPECT_NE( h, StringUtil::Hash( str, 1 ) );
+        hashes.insert( h );
+
+        // 忽略大小写的哈希等于转小写后的哈希
+        EXPECT_EQ( StringUtil::HashIgnoreCase( str ), StringUtil::Hash( StringUtil::ToLower( str ) ) ) << len;
+        EXPECT_EQ( StringUtil::HashIgnoreCase( str ), StringUtil::HashIgnoreCase( StringUtil::ToUpper( str ) ) ) << len;
+    }
+    EXPECT_EQ( hashes.size(), data.size() + 1 );
+
+    // 单个比特的变化应改变哈希值
+    std::string bits = data.substr( 0, 64 );
+    const auto  base = StringUtil::Hash( bits );
+    for ( size_t i = 0; i < bits.size(); ++i ) {
+        bits[i] ^= 1;
+        EXPECT_NE( StringUtil::Hash( bits ), base ) << i;
+        bits[i] ^= 1;
+    }
+}
+
+TEST( StringUtilTest, HashFunctors ) {
+    std::unordered_map<std::string_view, int, utils::StringHash, utils::StringEqual> counts;
+    for ( auto field : utils::StringUtil::SplitRef( "a,b,a,c,a,b", "," ) ) {
+        ++counts[field];
+    }
+    EXPECT_EQ( counts.size(), 3 );
+    EXPECT_EQ( counts["a"], 3 );
+    EXPECT_EQ( counts[std::string( "b" )], 2 );
+
+    std::unordered_map<std::string, int, utils::StringHashIgnoreCase, utils::StringEqualIgnoreCase> headers;
+    headers["Content-Type"] = 1;
+    headers["content-type"] = 2;
+    headers["ACCEPT"]       = 3;
+    EXPECT_EQ( headers.size(), 2 );
+    EXPECT_EQ( headers.at( "CONTENT-TYPE" ), 2 );
+    EXPECT_EQ( headers.count( "accept" ), 1 );
+
+#if defined( __cpp_lib_generic_unordered_lookup )
+    // C++20 起可用 string_view 直接查找 std::string 键，不构造临时字符串
+    std::unordered_map<std::string, int, utils::StringHash, utils::StringEqual> map{ { "key", 1 } };
+    EXPECT_NE( map.find( std::string_view( "key" ) ), map.end() );
+#endif
+}
+
+TEST( StringUtilTest, FindAny ) {
+    using utils::NeedleSet;
+    using utils::StringUtil;
+
+    NeedleSet needles{ "password", "token", "secret" };
+    auto      match = StringUtil::FindAny( "user=a token=xyz", needles );
+    ASSERT_TRUE( match.has_value() );
+    EXPECT_EQ( match->pattern, 1 );
+    EXPECT_EQ( match->offset, 7 );
+    EXPECT_EQ( match->length, 5 );
+    EXPECT_TRUE( StringUtil::ContainsAny( "my secret", needles ) );
+    EXPECT_FALSE( StringUtil::ContainsAny( "nothing here", needles ) );
+    EXPECT_FALSE( StringUtil::FindAny( "token", needles, 6 ).has_value() );
+
+    // 同一位置取最长，空关键字忽略，重复关键字取第一次的编号
+    NeedleSet overlapping{ "he", "", "she", "hers", "she" };
+    match = StringUtil::FindAny( "ushers", overlapping );
+    ASSERT_TRUE( match.has_value() );
+    EXPECT_EQ( match->pattern, 2 );
+    EXPECT_EQ( match->offset, 1 );
+    EXPECT_EQ( match->length, 3 );
+    EXPECT_FALSE( StringUtil::ContainsAny( "anything", NeedleSet{ "" } ) );
+
+    // 大量关键字时构建不应随数量平方增长，重复关键字仍取第一次的编号
+    std::vector<std::string> many;
+    for ( int i = 0; i < 40000; ++i ) {
+        many.push_back( "key-" + std::to_string( i ) + ";" );
+    }
+    many.push_back( "key-42;" );
+    const NeedleSet large( many );
+    EXPECT_EQ( large.Size(), 40001 );
+    match = StringUtil::FindAny( "a=1 key-39999; key-42;", large );
+    ASSERT_TRUE( match.has_value() );
+    EXPECT_EQ( match->pattern, 39999 );
+    EXPECT_EQ( match->offset, 4 );
+    match = StringUtil::FindAny( "key-42;", large );
+    ASSERT_TRUE( match.has_value() );
+    EXPECT_EQ( match->pattern, 42 );
+}
+
+TEST( StringUtilTest, FindAnyMatchesNaiveSearch ) {
+    using utils::NeedleSet;
+    using utils::StringUtil;
+
+    // 朴素实现：最靠左、同一位置最长、长度相同取编号小者
+    auto naive = []( std::string_view text, const std::vector<std::string> &needles, size_t pos ) {
+        for ( ; pos < text.size(); ++pos ) {
+            std::optional<NeedleSet::Match> best;
+            for ( size_t id = 0; id < needles.size(); ++id ) {
+                const auto &needle = needles[id];
+                if ( !needle.empty() && text.substr( pos, needle.size() ) == needle &&
+                     ( !best || needle.size() > best->length ) ) {
+                    best = NeedleSet::Match{ id, pos, needle.size() };
+                }
+            }
+            if ( best ) {
+                return best;
+            }
+        }
+        return std::optional<NeedleSet::Match>{};
+    };
+
+    uint32_t seed = 12345;
+    auto     rand = [&] { return seed = seed * 1103515245 + 12345, ( seed >> 16 ) & 0x7FFF; };
+    for ( size_t needle_count : { 1, 3, 8, 16, 17, 60 } ) {
+        std::vector<std::string> needles;
+        for ( size_t i = 0; i < needle_count; ++i ) {
+            std::string needle;
+            for ( size_t len = 1 + rand() % 6; needle.size() < len; ) {
+                needle += static_cast<char>( 'a' + rand() % 4 );
+            }
+            needles.push_back( needle );
+        }
+        const NeedleSet set( needles );
+
+        std::string text;
+        for ( int i = 0; i < 500; ++i ) {
+            text += static_cast<char>( 'a' + rand() % 6 );
+        }
+        for ( size_t pos = 0; pos <= text.size(); ++pos ) {
+            const auto expected = naive( text, needles, pos );
+            const auto actual   = StringUtil::FindAny( text, set, pos );
+            ASSERT_EQ( actual.has_value(), expected.has_value() ) << needle_count << " / " << pos;
+            if ( expected ) {
+                EXPECT_EQ( actual->pattern, expected->pattern ) << needle_count << " / " << pos;
+                EXPECT_EQ( actual->offset, expected->offset ) << needle_count << " / " << pos;
+                EXPECT_EQ( actual->length, expected->length ) << needle_count << " / " << pos;
+            }
+        }
+    }
+}
+
+TEST( StringUtilTest, EditDistance ) {
+    using utils::StringUtil;
+    EXPECT_EQ( StringUtil::EditDistance( "kitten", "sitting" ), 3 );
+    EXPECT_EQ( StringUtil::EditDistance( "", "abc" ), 3 );
+    EXPECT_EQ( StringUtil::EditDistance( "abc", "" ), 3 );
+    EXPECT_EQ( StringUtil::EditDistance( "same", "same" ), 0 );
+    EXPECT_EQ( StringUtil::EditDistance( "flaw", "lawn" ), 2 );
+    EXPECT_EQ( StringUtil::EditDistanceBounded( "kitten", "sitting", 3 ), 3 );
+    EXPECT_FALSE( StringUtil::EditDistanceBounded( "kitten", "sitting", 2 ).has_value() );
+    EXPECT_FALSE( StringUtil::EditDistanceBounded( "a", "abcdef", 4 ).has_value() );
+
+    // 与朴素动态规划对比，覆盖单块（<=64）和多块的模式串
+    auto naive = []( std::string_view a, std::string_view b ) {
+        std::vector<size_t> row( b.size() + 1 );
+        for ( size_t j = 0; j <= b.size(); ++j ) {
+            row[j] = j;
+        }
+        for ( size_t i = 1; i <= a.size(); ++i ) {
+            size_t diagonal = row[0];
+            row[0]          = i;
+            for ( size_t j = 1; j <= b.size(); ++j ) {
+                const size_t up = row[j];
+                row[j] = std::min( { row[j] + 1, row[j - 1] + 1, diagonal + ( a[i - 1] != b[j - 1] ? 1 : 0 ) } );
+                diagonal = up;
+            }
+        }
+        return row[b.size()];
+    };
+    uint32_t seed = 777;
+    auto     rand = [&] { return seed = seed * 1103515245 + 12345, ( seed >> 16 ) & 0x7FFF; };
+    auto     make = [&]( size_t length ) {
+        std::string str;
+        for ( size_t i = 0; i < length; ++i ) {
+            str += static_cast<char>( 'a' + rand() % 4 );
+        }
+        return str;
+    };
+    for ( int round = 0; round < 300; ++round ) {
+        const std::string a = make( rand() % 200 );
+        std::string       b = make( rand() % 200 );
+        if ( round % 3 == 0 ) {
+            b = a.substr( 0, a.size() / 2 ) + make( 3 ) + a.substr( a.size() / 2 );
+        }
+        const size_t expected = naive( a, b );
+        ASSERT_EQ( StringUtil::EditDistance( a, b ), expected ) << a << " / " << b;
+        EXPECT_EQ( StringUtil::EditDistanceBounded( a, b, expected ), expected );
+        if ( expected > 0 ) {
+            EXPECT_FALSE( StringUtil::EditDistanceBounded( a, b, expected - 1 ).has_value() );
+        }
+    }
+}
+
+TEST( StringUtilTest, FuzzyFindBest ) {
+    using utils::StringUtil;
+    const std::vector<std::string> commands{ "status", "commit", "checkout", "cherry-pick", "comment" };
+    auto                           best = StringUtil::FuzzyFindBest( "comit", commands, 2 );
+    ASSERT_TRUE( best.has_value() );
+    EXPECT_EQ( best->index, 1 );
+    EXPECT_EQ( best->distance, 1 );
+    EXPECT_FALSE( StringUtil::FuzzyFindBest( "xyz", commands, 2 ).has_value() );
+    EXPECT_FALSE( StringUtil::FuzzyFindBest( "xyz", std::vector<std::string>{} ).has_value() );
+
+    // 距离相同时取下标较小者
+    best = StringUtil::FuzzyFindBest( "ab", std::vector<std::string_view>{ "xb", "ax", "ab!" } );
+    ASSERT_TRUE( best.has_value() );
+    EXPECT_EQ( best->index, 0 );
+    EXPECT_EQ( best->distance, 1 );
+
+    // 大量候选中找出唯一的近似项，长查询走多块路径
+    std::vector<std::string> hosts;
+    for ( int i = 0; i < 100000; ++i ) {
+        hosts.push_back( "host-" + std::to_string( i * 7919 % 100000 ) + ".dc1.example.com" );
+    }
+    const std::string target = hosts[4242];
+    std::string       query  = target;
+    query[2]                 = 'X';
+    best                     = StringUtil::FuzzyFindBest( query, hosts );
+    ASSERT_TRUE( best.has_value() );
+    EXPECT_EQ( best->index, 4242 );
+    EXPECT_EQ( best->distance, 1 );
+
+    const std::string long_query = std::string( 100, 'q' ) + target;
+    best = StringUtil::FuzzyFindBest( long_query, hosts, 100 );
+    ASSERT_TRUE( best.has_value() );
+    EXPECT_EQ( best->index, 4242 );
+    EXPECT_EQ( best->distance, 100 );
+}
+
 TEST( StringUtilTest, IsNumeric ) {
     // 测试整数
     EXPECT_TRUE( utils::StringUtil::IsNumeric( "123" ) );